@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/SlashBenchmarkReport.h"
+#include "Benchmark/SlashBenchmarkTimers.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "UObject/UObjectGlobals.h"
+#include "Slash.h"
+
+FSlashBenchmarkReport::~FSlashBenchmarkReport()
+{
+	End();
+}
+
+void FSlashBenchmarkReport::Begin(UWorld* InWorld)
+{
+	End();
+
+	World = InWorld;
+	bMeasuring = true;
+	StartWallTime = LastFrameWallTime = FPlatformTime::Seconds();
+	FrameTimesMs.Reset();
+	GameThreadTimesMs.Reset();
+	NumSpawns = 0;
+	NumGarbageCollections = 0;
+	GarbageCollectionMs = 0.0;
+
+	if (InWorld)
+	{
+		ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FSlashBenchmarkReport::OnActorSpawned));
+	}
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FSlashBenchmarkReport::OnPreGarbageCollect);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FSlashBenchmarkReport::OnPostGarbageCollect);
+
+	FSlashBenchmarkTimer::ResetAll();
+	FSlashBenchmarkTimer::bEnabled = true;
+}
+
+void FSlashBenchmarkReport::End()
+{
+	if (!bMeasuring) return;
+
+	bMeasuring = false;
+	EndWallTime = FPlatformTime::Seconds();
+	FSlashBenchmarkTimer::bEnabled = false;
+
+	if (UWorld* MeasuredWorld = World.Get())
+	{
+		MeasuredWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+void FSlashBenchmarkReport::RecordFrame()
+{
+	if (!bMeasuring) return;
+
+	const double Now = FPlatformTime::Seconds();
+	FrameTimesMs.Add((Now - LastFrameWallTime) * 1000.0);
+	GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	LastFrameWallTime = Now;
+}
+
+void FSlashBenchmarkReport::Write(const FString& ReportPath, TFunctionRef<void(TJsonWriter<>&)> WriteHeader) const
+{
+	const int32 NumFrames = FrameTimesMs.Num();
+	if (NumFrames == 0) return;
+
+	FString Csv = TEXT("Frame,FrameMs,GameThreadMs\n");
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Csv += FString::Printf(TEXT("%d,%.4f,%.4f\n"), Frame, FrameTimesMs[Frame], GameThreadTimesMs[Frame]);
+	}
+	FFileHelper::SaveStringToFile(Csv, *(ReportPath + TEXT(".csv")));
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	auto WriteDistribution = [&Writer](const TCHAR* Name, TArray<float> Samples)
+	{
+		Samples.Sort();
+		double Total = 0.0;
+		for (const float Sample : Samples) Total += Sample;
+
+		auto Percentile = [&Samples](double Fraction) { return Samples[FMath::Min(FMath::FloorToInt32(Fraction * Samples.Num()), Samples.Num() - 1)]; };
+
+		Writer->WriteObjectStart(Name);
+		Writer->WriteValue(TEXT("avg"), Total / Samples.Num());
+		Writer->WriteValue(TEXT("p50"), Percentile(0.5));
+		Writer->WriteValue(TEXT("p95"), Percentile(0.95));
+		Writer->WriteValue(TEXT("p99"), Percentile(0.99));
+		Writer->WriteValue(TEXT("max"), Samples.Last());
+		Writer->WriteObjectEnd();
+	};
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("build"), FApp::GetBuildVersion());
+	WriteHeader(*Writer);
+	Writer->WriteValue(TEXT("wallSeconds"), (bMeasuring ? FPlatformTime::Seconds() : EndWallTime) - StartWallTime);
+	Writer->WriteValue(TEXT("frames"), NumFrames);
+
+	WriteDistribution(TEXT("frameMs"), FrameTimesMs);
+	WriteDistribution(TEXT("gameThreadMs"), GameThreadTimesMs);
+
+	Writer->WriteArrayStart(TEXT("ticks"));
+	for (const FSlashBenchmarkTimer* Timer = FSlashBenchmarkTimer::First; Timer; Timer = Timer->Next)
+	{
+		if (Timer->Calls == 0) continue;
+
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Timer->Cycles);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Timer->Name);
+		Writer->WriteValue(TEXT("calls"), static_cast<int64>(Timer->Calls));
+		Writer->WriteValue(TEXT("totalMs"), TotalMs);
+		Writer->WriteValue(TEXT("msPerFrame"), TotalMs / NumFrames);
+		Writer->WriteValue(TEXT("usPerCall"), TotalMs * 1000.0 / Timer->Calls);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteValue(TEXT("traces"), static_cast<int64>(FSlashBenchmarkTimer::NumTraces));
+	Writer->WriteValue(TEXT("tracesPerFrame"), static_cast<double>(FSlashBenchmarkTimer::NumTraces) / NumFrames);
+	Writer->WriteValue(TEXT("spawns"), static_cast<int64>(NumSpawns));
+	Writer->WriteObjectStart(TEXT("gc"));
+	Writer->WriteValue(TEXT("count"), static_cast<int64>(NumGarbageCollections));
+	Writer->WriteValue(TEXT("totalMs"), GarbageCollectionMs);
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	FFileHelper::SaveStringToFile(Json, *(ReportPath + TEXT(".json")));
+	UE_LOG(LogSlash, Display, TEXT("Benchmark: %d frames, report written to %s.json"), NumFrames, *ReportPath);
+}
+
+void FSlashBenchmarkReport::OnActorSpawned(AActor* Actor)
+{
+	++NumSpawns;
+}
+
+void FSlashBenchmarkReport::OnPreGarbageCollect()
+{
+	GarbageCollectionStart = FPlatformTime::Seconds();
+}
+
+void FSlashBenchmarkReport::OnPostGarbageCollect()
+{
+	++NumGarbageCollections;
+	GarbageCollectionMs += (FPlatformTime::Seconds() - GarbageCollectionStart) * 1000.0;
+}
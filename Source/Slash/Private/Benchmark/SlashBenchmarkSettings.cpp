@@ -0,0 +1,9 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/SlashBenchmarkSettings.h"
+
+USlashBenchmarkSettings::USlashBenchmarkSettings()
+{
+	CategoryName = TEXT("Game");
+}
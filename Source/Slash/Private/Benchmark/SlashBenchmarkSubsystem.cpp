@@ -0,0 +1,309 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/SlashBenchmarkSubsystem.h"
+#include "Benchmark/SlashBenchmarkSettings.h"
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemyAnimInstance.h"
+#include "Characters/SlashCharacter.h"
+#include "Breakable/BreakableActor.h"
+#include "Items/Item.h"
+#include "Items/Weapons/Weapon.h"
+#include "Items/ItemPoolSubsystem.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Algo/Count.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Slash.h"
+
+bool USlashBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("SlashBenchmark"));
+}
+
+void USlashBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ParseOptions();
+	Stream.Initialize(Options.Seed);
+	FMath::RandInit(Options.Seed);
+	FMath::SRandInit(Options.Seed);
+	if (URandomStreamSubsystem* RandomStreams = InWorld.GetSubsystem<URandomStreamSubsystem>())
+	{
+		RandomStreams->SetSeed(Options.Seed);
+	}
+
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / Options.FixedFrameRate);
+
+	GenerateArena();
+	SpawnPopulation();
+
+	bRunning = true;
+
+	UE_LOG(LogSlash, Display, TEXT("Benchmark: seed %d, %d enemies, %d stand-ins, %d breakables, %d pickups, %.0fs at %.0f fps"),
+		Options.Seed, Enemies.Num(), StandIns.Num(), Options.NumBreakables, Options.NumPickups, Options.Duration, Options.FixedFrameRate);
+}
+
+void USlashBenchmarkSubsystem::Deinitialize()
+{
+	Report.End();
+
+	Super::Deinitialize();
+}
+
+void USlashBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	if (!bRunning) return;
+
+	SimulatedTime += DeltaTime;
+	if (SimulatedTime >= NextAttackTime)
+	{
+		DriveStandIns();
+		NextAttackTime += GetDefault<USlashBenchmarkSettings>()->AttackInterval;
+	}
+
+	if (Report.IsMeasuring())
+	{
+		Report.RecordFrame();
+	}
+	else if (SimulatedTime >= Options.Warmup)
+	{
+		Report.Begin(GetWorld());
+	}
+
+	if (SimulatedTime >= Options.Warmup + Options.Duration)
+	{
+		FinishRun();
+	}
+}
+
+TStatId USlashBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+bool USlashBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlashBenchmarkSubsystem::ParseOptions()
+{
+	const USlashBenchmarkSettings* Settings = GetDefault<USlashBenchmarkSettings>();
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	Options.Seed = Settings->Seed;
+	Options.Duration = Settings->Duration;
+	Options.Warmup = Settings->Warmup;
+	Options.FixedFrameRate = Settings->FixedFrameRate;
+	Options.NumEnemies = Settings->NumEnemies;
+	Options.NumStandIns = Settings->NumStandIns;
+	Options.NumBreakables = Settings->NumBreakables;
+	Options.NumPickups = Settings->NumPickups;
+	Options.ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("Slash-%s"), *FDateTime::Now().ToString());
+
+	FParse::Value(CommandLine, TEXT("BenchSeed="), Options.Seed);
+	FParse::Value(CommandLine, TEXT("BenchSeconds="), Options.Duration);
+	FParse::Value(CommandLine, TEXT("BenchWarmup="), Options.Warmup);
+	FParse::Value(CommandLine, TEXT("BenchFps="), Options.FixedFrameRate);
+	FParse::Value(CommandLine, TEXT("BenchEnemies="), Options.NumEnemies);
+	FParse::Value(CommandLine, TEXT("BenchStandIns="), Options.NumStandIns);
+	FParse::Value(CommandLine, TEXT("BenchBreakables="), Options.NumBreakables);
+	FParse::Value(CommandLine, TEXT("BenchPickups="), Options.NumPickups);
+	FParse::Value(CommandLine, TEXT("BenchReport="), Options.ReportPath);
+	Options.bExitWhenDone = !FParse::Param(CommandLine, TEXT("BenchNoExit"));
+
+	Options.FixedFrameRate = FMath::Max(Options.FixedFrameRate, 1.f);
+}
+
+void USlashBenchmarkSubsystem::GenerateArena()
+{
+	const USlashBenchmarkSettings* Settings = GetDefault<USlashBenchmarkSettings>();
+	UWorld* World = GetWorld();
+
+	if (UStaticMesh* FloorMesh = Settings->FloorMesh.LoadSynchronous())
+	{
+		if (AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(Settings->ArenaOrigin, FRotator::ZeroRotator))
+		{
+			Floor->SetMobility(EComponentMobility::Movable);
+			Floor->GetStaticMeshComponent()->SetStaticMesh(FloorMesh);
+
+			const FVector MeshSize = FloorMesh->GetBoundingBox().GetSize();
+			const double ArenaSize = Settings->ArenaHalfExtent * 2.0;
+			Floor->SetActorScale3D(FVector(ArenaSize / FMath::Max(MeshSize.X, 1.0), ArenaSize / FMath::Max(MeshSize.Y, 1.0), 1.0));
+		}
+	}
+
+	const double PatrolRingRadius = Settings->ArenaHalfExtent * 0.6;
+	for (int32 Index = 0; Index < Settings->NumPatrolPoints; ++Index)
+	{
+		const double Angle = UE_TWO_PI * Index / Settings->NumPatrolPoints;
+		const FVector Location = Settings->ArenaOrigin + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0) * PatrolRingRadius;
+		if (ATargetPoint* PatrolPoint = World->SpawnActor<ATargetPoint>(Location, FRotator::ZeroRotator))
+		{
+			PatrolPoints.Add(PatrolPoint);
+		}
+	}
+}
+
+void USlashBenchmarkSubsystem::SpawnPopulation()
+{
+	const USlashBenchmarkSettings* Settings = GetDefault<USlashBenchmarkSettings>();
+	UWorld* World = GetWorld();
+	UItemPoolSubsystem* ItemPool = World->GetSubsystem<UItemPoolSubsystem>();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// The player's pawn joins the stand-ins so enemy LOD has a focus point inside the arena
+	TSubclassOf<AWeapon> WeaponClass = Settings->StandInWeaponClass.LoadSynchronous();
+	TArray<ASlashCharacter*> Candidates;
+	if (ASlashCharacter* Player = Cast<ASlashCharacter>(UGameplayStatics::GetPlayerPawn(World, 0)))
+	{
+		Player->TeleportTo(Settings->ArenaOrigin + FVector(0.0, 0.0, 100.0), FRotator::ZeroRotator);
+		Candidates.Add(Player);
+	}
+
+	if (UClass* StandInClass = Settings->StandInClass.LoadSynchronous())
+	{
+		for (int32 Index = 0; Index < Options.NumStandIns; ++Index)
+		{
+			const double Angle = Stream.FRandRange(0.0, UE_TWO_PI);
+			const FVector Location = Settings->ArenaOrigin + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0) * Stream.FRandRange(200.0, 1000.0) + FVector(0.0, 0.0, 100.0);
+			if (ASlashCharacter* StandIn = World->SpawnActor<ASlashCharacter>(StandInClass, Location, FRotator::ZeroRotator, SpawnParams))
+			{
+				StandIn->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+				Candidates.Add(StandIn);
+			}
+		}
+	}
+
+	for (ASlashCharacter* StandIn : Candidates)
+	{
+		if (ItemPool && WeaponClass)
+		{
+			if (AWeapon* Weapon = ItemPool->Acquire<AWeapon>(WeaponClass, StandIn->GetActorLocation(), StandIn->GetActorRotation(), StandIn))
+			{
+				StandIn->EquipWeapon(Weapon);
+			}
+		}
+		StandIns.Add(StandIn);
+	}
+
+	TArray<UClass*> EnemyClasses;
+	for (const TSoftClassPtr<AEnemy>& EnemyClass : Settings->EnemyClasses)
+	{
+		if (UClass* LoadedClass = EnemyClass.LoadSynchronous()) EnemyClasses.Add(LoadedClass);
+	}
+
+	for (int32 Index = 0; Index < Options.NumEnemies && EnemyClasses.Num() > 0; ++Index)
+	{
+		UClass* EnemyClass = EnemyClasses[Stream.RandRange(0, EnemyClasses.Num() - 1)];
+		const FTransform SpawnTransform(FRotator(0.0, Stream.FRandRange(0.0, 360.0), 0.0), RandomArenaLocation(100.0));
+		if (AEnemy* Enemy = World->SpawnActorDeferred<AEnemy>(EnemyClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn))
+		{
+			Enemy->SetPatrolTargets(PatrolPoints);
+			UGameplayStatics::FinishSpawningActor(Enemy, SpawnTransform);
+			Enemies.Add(Enemy);
+		}
+	}
+
+	TArray<UClass*> BreakableClasses;
+	for (const TSoftClassPtr<ABreakableActor>& BreakableClass : Settings->BreakableClasses)
+	{
+		if (UClass* LoadedClass = BreakableClass.LoadSynchronous()) BreakableClasses.Add(LoadedClass);
+	}
+
+	for (int32 Index = 0; Index < Options.NumBreakables && BreakableClasses.Num() > 0; ++Index)
+	{
+		UClass* BreakableClass = BreakableClasses[Stream.RandRange(0, BreakableClasses.Num() - 1)];
+		World->SpawnActor<ABreakableActor>(BreakableClass, RandomArenaLocation(0.0), FRotator::ZeroRotator, SpawnParams);
+	}
+
+	TArray<UClass*> PickupClasses;
+	for (const TSoftClassPtr<AItem>& PickupClass : Settings->PickupClasses)
+	{
+		if (UClass* LoadedClass = PickupClass.LoadSynchronous()) PickupClasses.Add(LoadedClass);
+	}
+
+	for (int32 Index = 0; Index < Options.NumPickups && ItemPool && PickupClasses.Num() > 0; ++Index)
+	{
+		UClass* PickupClass = PickupClasses[Stream.RandRange(0, PickupClasses.Num() - 1)];
+		ItemPool->Acquire(PickupClass, RandomArenaLocation(50.0), FRotator::ZeroRotator);
+	}
+}
+
+FVector USlashBenchmarkSubsystem::RandomArenaLocation(double ZOffset)
+{
+	const USlashBenchmarkSettings* Settings = GetDefault<USlashBenchmarkSettings>();
+	const double HalfExtent = Settings->ArenaHalfExtent;
+	return Settings->ArenaOrigin + FVector(Stream.FRandRange(-HalfExtent, HalfExtent), Stream.FRandRange(-HalfExtent, HalfExtent), ZOffset);
+}
+
+void USlashBenchmarkSubsystem::DriveStandIns()
+{
+	for (ASlashCharacter* StandIn : StandIns)
+	{
+		if (!IsValid(StandIn) || StandIn->GetActionState() == EActionState::EAS_Dead) continue;
+
+		AEnemy* NearestEnemy = nullptr;
+		double NearestDistanceSquared = TNumericLimits<double>::Max();
+		for (AEnemy* Enemy : Enemies)
+		{
+			if (!IsValid(Enemy) || Enemy->GetEnemyState() == EEnemyState::EES_Dead) continue;
+
+			const double DistanceSquared = FVector::DistSquared(Enemy->GetActorLocation(), StandIn->GetActorLocation());
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestEnemy = Enemy;
+			}
+		}
+
+		if (NearestEnemy)
+		{
+			const FVector ToEnemy = NearestEnemy->GetActorLocation() - StandIn->GetActorLocation();
+			StandIn->SetActorRotation(FRotator(0.0, ToEnemy.Rotation().Yaw, 0.0));
+		}
+		StandIn->Attack(FInputActionValue());
+	}
+}
+
+void USlashBenchmarkSubsystem::FinishRun()
+{
+	bRunning = false;
+	Report.End();
+
+	Report.Write(Options.ReportPath, [this](TJsonWriter<>& Writer)
+	{
+		Writer.WriteValue(TEXT("seed"), Options.Seed);
+		Writer.WriteValue(TEXT("commandLine"), FCommandLine::Get());
+		Writer.WriteValue(TEXT("fixedFrameRate"), Options.FixedFrameRate);
+		Writer.WriteValue(TEXT("simulatedSeconds"), Options.Duration);
+
+		Writer.WriteObjectStart(TEXT("population"));
+		Writer.WriteValue(TEXT("enemies"), Enemies.Num());
+		Writer.WriteValue(TEXT("threadSafeEnemyAnims"), Algo::CountIf(Enemies, [](const AEnemy* Enemy)
+		{
+			return IsValid(Enemy) && Cast<UEnemyAnimInstance>(Enemy->GetMesh()->GetAnimInstance()) != nullptr;
+		}));
+		Writer.WriteValue(TEXT("standIns"), StandIns.Num());
+		Writer.WriteValue(TEXT("breakables"), Options.NumBreakables);
+		Writer.WriteValue(TEXT("pickups"), Options.NumPickups);
+		Writer.WriteObjectEnd();
+	});
+
+	if (Options.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Benchmark/SlashBenchmarkTimers.h"
+
+FSlashBenchmarkTimer* FSlashBenchmarkTimer::First = nullptr;
+bool FSlashBenchmarkTimer::bEnabled = false;
+uint32 FSlashBenchmarkTimer::NumTraces = 0;
+
+FSlashBenchmarkTimer::FSlashBenchmarkTimer(const TCHAR* InName)
+	: Name(InName)
+	, Next(First)
+{
+	First = this;
+}
+
+void FSlashBenchmarkTimer::ResetAll()
+{
+	for (FSlashBenchmarkTimer* Timer = First; Timer; Timer = Timer->Next)
+	{
+		Timer->Cycles = 0;
+		Timer->Calls = 0;
+	}
+	NumTraces = 0;
+}
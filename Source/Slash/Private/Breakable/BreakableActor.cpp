@@ -5,10 +5,17 @@
 #include "GeometryCollection/GeometryCollectionComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Items/Treasure.h"
+#include "Items/ItemPoolSubsystem.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "Slash/SlashStats.h"
+#include "Net/UnrealNetwork.h"
 
 ABreakableActor::ABreakableActor()
 {
 	PrimaryActorTick.bCanEverTick = false;
+
+	// Broken by the server's weapon hits
+	bReplicates = true;
 	
 	GeometryCollection = CreateDefaultSubobject<UGeometryCollectionComponent>(TEXT("GeometryCollection"));
 	SetRootComponent(GeometryCollection);
@@ -32,6 +39,21 @@ void ABreakableActor::BeginPlay()
 	GeometryCollection->OnChaosBreakEvent.AddDynamic(this, &ABreakableActor::OnBreak);
 }
 
+void ABreakableActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ABreakableActor, bBroken);
+}
+
+void ABreakableActor::OnRep_Broken()
+{
+	if (bBroken)
+	{
+		Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
+	}
+}
+
 void ABreakableActor::OnBreak(const FChaosBreakEvent& BreakEvent)
 {
 	this->SetLifeSpan(3.f);
@@ -49,12 +71,15 @@ void ABreakableActor::GetHit_Implementation(const FVector& ImpactPoint, AActor*
 	if (bBroken) return;
 
 	bBroken = true;
-	UWorld* World = GetWorld();
-	if (World && TreasureClasses.Num() > 0)
+	UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>();
+	if (ItemPool && TreasureClasses.Num() > 0)
 	{
-		const int32 Selection = FMath::RandRange(0, TreasureClasses.Num() - 1);
+		const int32 Selection = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_Loot).RandRange(0, TreasureClasses.Num() - 1);
 
-		World->SpawnActor<ATreasure>(TreasureClasses[Selection], GetActorLocation(), GetActorRotation());
+		if (ItemPool->Acquire<ATreasure>(TreasureClasses[Selection], GetActorLocation(), GetActorRotation()))
+		{
+			INC_DWORD_STAT(STAT_SlashPickupsSpawned);
+		}
 	}
 }
 
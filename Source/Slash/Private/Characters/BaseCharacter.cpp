@@ -6,15 +6,33 @@
 #include "EnhancedInputComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/FactionComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Items/Weapons/Weapon.h"
+#include "Spatial/PawnSpatialGridSubsystem.h"
+#include "Combat/CombatEventSubsystem.h"
+#include "Combat/HitDirectionClassifier.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "Animation/AnimMontage.h"
+#include "Net/UnrealNetwork.h"
+
+namespace
+{
+	// Indexed by EHitReactDirection
+	const FName HitReactSectionNames[] = { FName("FromFront"), FName("FromBack"), FName("FromLeft"), FName("FromRight") };
+	static_assert(UE_ARRAY_COUNT(HitReactSectionNames) == static_cast<int32>(EHitReactDirection::EHR_MAX));
+
+	const FName DodgeSectionNames[] = { FName("Default") };
+}
 
-ABaseCharacter::ABaseCharacter()
+ABaseCharacter::ABaseCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
 
 	Attributes = CreateDefaultSubobject<UAttributeComponent>(TEXT("Attributes"));
+	Faction = CreateDefaultSubobject<UFactionComponent>(TEXT("Faction"));
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 }
 
@@ -24,10 +42,39 @@ void ABaseCharacter::Tick(float DeltaTime)
 
 }
 
+void ABaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ABaseCharacter, Equipped1hWeapon);
+	DOREPLIFETIME(ABaseCharacter, Equipped2hWeapon);
+	DOREPLIFETIME(ABaseCharacter, DeathPose);
+}
+
 void ABaseCharacter::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (UPawnSpatialGridSubsystem* PawnGrid = GetWorld()->GetSubsystem<UPawnSpatialGridSubsystem>())
+	{
+		PawnGrid->RegisterPawn(this);
+	}
+
+	GetSectionCache(AttackMontage_1h);
+	GetSectionCache(AttackMontage_2h);
+	GetSectionCache(HitReactMontage, HitReactSectionNames);
+	GetSectionCache(DeathMontage);
+	GetSectionCache(DodgeMontage, DodgeSectionNames);
+}
+
+void ABaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPawnSpatialGridSubsystem* PawnGrid = GetWorld()->GetSubsystem<UPawnSpatialGridSubsystem>())
+	{
+		PawnGrid->UnregisterPawn(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABaseCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
@@ -41,9 +88,14 @@ void ABaseCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor* H
 	{
 		Die();
 	}
+	IncomingHitDirection.Reset();
 
-	PlayHitSound(ImpactPoint);
-	SpawnHitParticles(ImpactPoint);
+	MulticastHitEffects(ImpactPoint);
+}
+
+void ABaseCharacter::SetIncomingHitDirection(EHitReactDirection Direction)
+{
+	IncomingHitDirection = Direction;
 }
 
 bool ABaseCharacter::CanAttack()
@@ -57,7 +109,7 @@ void ABaseCharacter::Attack(const FInputActionValue& Value)
 
 void ABaseCharacter::Attack()
 {
-	if (CombatTarget && CombatTarget->ActorHasTag(FName("Dead")))
+	if (CombatTarget && UFactionComponent::IsDead(CombatTarget))
 	{
 		CombatTarget = nullptr;
 	}
@@ -65,8 +117,9 @@ void ABaseCharacter::Attack()
 
 void ABaseCharacter::Die_Implementation()
 {
-	Tags.Add(FName("Dead"));
+	Faction->AddState(EFactionStateFlags::Dead);
 	PlayDeathMontage();
+	UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Death, CombatTarget, this, 0.f, GetActorLocation());
 }
 
 void ABaseCharacter::DisableCapsule()
@@ -79,6 +132,16 @@ void ABaseCharacter::DisableMeshCollision()
 	GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
+void ABaseCharacter::EnableCapsule()
+{
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+}
+
+void ABaseCharacter::EnableMeshCollision()
+{
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
 void ABaseCharacter::HandleDamage(float DamageAmount)
 {
 	if (Attributes)
@@ -89,44 +152,11 @@ void ABaseCharacter::HandleDamage(float DamageAmount)
 
 void ABaseCharacter::DirectionalHitReact(const FVector& ImpactPoint)
 {
-	const FVector Forward = GetActorForwardVector();
-	const FVector ImpactLowered(ImpactPoint.X, ImpactPoint.Y, GetActorLocation().Z);
-	const FVector ToHit = (ImpactLowered - GetActorLocation()).GetSafeNormal();
-
-	// Forward * ToHit = |Forward|||ToHit| * cos(theta)
-	// cos(theta) = Forward * ToHit, since |Forward| = 1 and |ToHit| = 1
-	const double CosTheta = FVector::DotProduct(Forward, ToHit);
-
-	// Take the inverse cosine of cos(theta) to get theta
-	double Theta = FMath::Acos(CosTheta);
-
-	// convert from radians to degrees
-	Theta = FMath::RadiansToDegrees(Theta);
-
-	// if CrossProduct points down, Theta should be negative
-	const FVector CrossProduct = FVector::CrossProduct(Forward, ToHit);
-
-	if (CrossProduct.Z < 0)
-	{
-		Theta *= -1.f;
-	}
-
-	FName Section("FromBack");
-
-	if (Theta >= -45.f && Theta < 45.f)
-	{
-		Section = FName("FromFront");
-	}
-	else if (Theta >= -135.f && Theta < -45.f)
-	{
-		Section = FName("FromLeft");
-	}
-	else if (Theta >= 45.f && Theta < 135.f)
-	{
-		Section = FName("FromRight");
-	}
+	const EHitReactDirection Direction = IncomingHitDirection.IsSet() ?
+		IncomingHitDirection.GetValue() :
+		FHitDirectionClassifier::Classify(GetActorForwardVector(), GetActorLocation(), ImpactPoint);
 
-	PlayHitReactMontage(Section);
+	MulticastHitReact(Direction);
 }
 
 void ABaseCharacter::PlayHitSound(const FVector& ImpactPoint)
@@ -145,19 +175,22 @@ void ABaseCharacter::SpawnHitParticles(const FVector& ImpactPoint)
 	}
 }
 
-void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
+void ABaseCharacter::PlayHitReactMontage(EHitReactDirection Direction)
 {
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance && HitReactMontage)
+	if (HitReactMontage)
 	{
-		AnimInstance->Montage_Play(HitReactMontage);
-		AnimInstance->Montage_JumpToSection(SectionName, HitReactMontage);
+		PlayMontageSection(HitReactMontage, GetSectionCache(HitReactMontage, HitReactSectionNames).GetSlotSection(static_cast<int32>(Direction)));
 	}
 }
 
-void ABaseCharacter::PlayAttackMontage(UAnimMontage* AttackMontage)
+int32 ABaseCharacter::PlayAttackMontage(UAnimMontage* AttackMontage)
 {
-	PlayRandomMontageSection(AttackMontage);
+	const int32 Selection = PlayRandomMontageSection(AttackMontage);
+	if (Selection != -1 && HasAuthority())
+	{
+		MulticastPlayMontageSection(AttackMontage, Selection);
+	}
+	return Selection;
 }
 
 int32 ABaseCharacter::PlayDeathMontage()
@@ -175,7 +208,15 @@ int32 ABaseCharacter::PlayDeathMontage()
 
 void ABaseCharacter::PlayDodgeMontage()
 {
-	PlayMontageSection(DodgeMontage, FName("Default"));
+	if (DodgeMontage)
+	{
+		const int32 Section = GetSectionCache(DodgeMontage, DodgeSectionNames).GetSlotSection(0);
+		PlayMontageSection(DodgeMontage, Section);
+		if (HasAuthority())
+		{
+			MulticastPlayMontageSection(DodgeMontage, Section);
+		}
+	}
 }
 
 FVector ABaseCharacter::GetTranslationWarpTarget()
@@ -226,40 +267,87 @@ void ABaseCharacter::DodgeEnd()
 
 void ABaseCharacter::SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled)
 {
-	if (Equipped1hWeapon && Equipped1hWeapon->GetWeaponBox())
+	if (Equipped1hWeapon)
 	{
-		Equipped1hWeapon->GetWeaponBox()->SetCollisionEnabled(CollisionEnabled);
-		Equipped1hWeapon->IgnoreActors.Empty();
+		Equipped1hWeapon->SetWeaponCollisionEnabled(CollisionEnabled);
 	}
 
-	if (Equipped2hWeapon && Equipped2hWeapon->GetWeaponBox())
+	if (Equipped2hWeapon)
 	{
-		Equipped2hWeapon->GetWeaponBox()->SetCollisionEnabled(CollisionEnabled);
-		Equipped2hWeapon->IgnoreActors.Empty();
+		Equipped2hWeapon->SetWeaponCollisionEnabled(CollisionEnabled);
 	}
 }
 
-void ABaseCharacter::PlayMontageSection(UAnimMontage* Montage, const FName& SectionName)
+void ABaseCharacter::MulticastPlayMontageSection_Implementation(UAnimMontage* Montage, int32 Section)
+{
+	// Already playing on the server, and on the owning client that predicted it
+	if (HasAuthority() || IsLocallyControlled()) return;
+
+	PlayMontageSection(Montage, Section);
+}
+
+void ABaseCharacter::MulticastHitReact_Implementation(EHitReactDirection Direction)
+{
+	PlayHitReactMontage(Direction);
+}
+
+void ABaseCharacter::MulticastHitEffects_Implementation(FVector_NetQuantize ImpactPoint)
+{
+	PlayHitSound(ImpactPoint);
+	SpawnHitParticles(ImpactPoint);
+}
+
+void ABaseCharacter::OnRep_DeathPose()
+{
+	if (DeathPose >= EDeathPose::EDP_MAX) return;
+
+	// Death montage sections are in EDeathPose order, see PlayDeathMontage
+	Faction->AddState(EFactionStateFlags::Dead);
+	PlayMontageSection(DeathMontage, DeathPose);
+}
+
+void ABaseCharacter::PlayMontageSection(UAnimMontage* Montage, int32 Section)
 {
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 
 	if (AnimInstance && Montage)
 	{
-		AnimInstance->Montage_Play(Montage);
-		AnimInstance->Montage_JumpToSection(SectionName, Montage);
+		// Starting at the section is the same as jumping to it, missing sections play from the start
+		const FMontageSectionCache& Cache = GetSectionCache(Montage);
+		const float StartTime = Section >= 0 && Section < Cache.GetNumSections() ? Cache.GetSectionStartTime(Section) : 0.f;
+		AnimInstance->Montage_Play(Montage, 1.f, EMontagePlayReturnType::MontageLength, StartTime);
+	}
+}
+
+const FMontageSectionCache& ABaseCharacter::GetSectionCache(const UAnimMontage* Montage, TArrayView<const FName> SlotNames)
+{
+	FMontageSectionCache* Cache = SectionCaches.Find(Montage);
+	if (Cache == nullptr)
+	{
+		Cache = &SectionCaches.Add(Montage);
+		Cache->Build(Montage, SlotNames, SectionWeights);
+	}
+	else if (SlotNames.Num() > 0 && Cache->GetNumSlots() == 0)
+	{
+		// First cached without slots, e.g. by PlayMontageSection on a multicast montage
+		Cache->BuildSlots(Montage, SlotNames);
+	}
+	else
+	{
+		ensureMsgf(SlotNames.Num() == 0 || SlotNames.Num() == Cache->GetNumSlots(),
+			TEXT("%s: montage %s was cached with %d slots, asked for %d"), *GetName(), *GetNameSafe(Montage), Cache->GetNumSlots(), SlotNames.Num());
 	}
+	return *Cache;
 }
 
 int32 ABaseCharacter::PlayRandomMontageSection(UAnimMontage* Montage)
 {
 	if (!Montage) return -1;
 
-	const int32 MontageSections = Montage->GetNumSections();
+	const int32 Selection = GetSectionCache(Montage).PickWeighted(URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_Animation));
 
-	if (MontageSections <= 0) return -1;
+	if (Selection == INDEX_NONE) return -1;
 
-	const int32 Selection = FMath::RandRange(0, MontageSections - 1);
-	const FName SectionName = Montage->GetSectionName(Selection);
-	PlayMontageSection(Montage, SectionName);
+	PlayMontageSection(Montage, Selection);
 	return Selection;
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/MontageSectionCache.h"
+#include "Animation/AnimMontage.h"
+#include "Algo/BinarySearch.h"
+
+void FMontageSectionCache::Build(const UAnimMontage* Montage, TArrayView<const FName> SlotNames, const TMap<FName, float>& Weights)
+{
+	SectionStartTimes.Reset();
+	CumulativeWeights.Reset();
+
+	const int32 NumSections = Montage ? Montage->GetNumSections() : 0;
+	float TotalWeight = 0.f;
+	for (int32 Section = 0; Section < NumSections; ++Section)
+	{
+		const FName SectionName = Montage->GetSectionName(Section);
+		const float* Weight = Weights.Find(SectionName);
+		TotalWeight += Weight ? FMath::Max(*Weight, 0.f) : 1.f;
+
+		SectionStartTimes.Add(Montage->CompositeSections[Section].GetTime());
+		CumulativeWeights.Add(TotalWeight);
+	}
+
+	BuildSlots(Montage, SlotNames);
+}
+
+void FMontageSectionCache::BuildSlots(const UAnimMontage* Montage, TArrayView<const FName> SlotNames)
+{
+	SlotSections.Reset();
+	for (const FName& SlotName : SlotNames)
+	{
+		SlotSections.Add(Montage ? Montage->GetSectionIndex(SlotName) : INDEX_NONE);
+	}
+}
+
+int32 FMontageSectionCache::PickWeighted(FRandomStream& Stream) const
+{
+	if (CumulativeWeights.Num() == 0 || CumulativeWeights.Last() <= 0.f) return INDEX_NONE;
+
+	// First section whose cumulative weight exceeds the roll
+	const float Roll = Stream.FRand() * CumulativeWeights.Last();
+	const int32 Section = Algo::UpperBound(CumulativeWeights, Roll);
+	return FMath::Min(Section, CumulativeWeights.Num() - 1);
+}
+
+int32 FMontageSectionCache::GetSlotSection(int32 Slot) const
+{
+	return SlotSections.IsValidIndex(Slot) ? SlotSections[Slot] : INDEX_NONE;
+}
+
+float FMontageSectionCache::GetSectionWeight(int32 Section) const
+{
+	if (!CumulativeWeights.IsValidIndex(Section)) return 0.f;
+
+	return Section > 0 ? CumulativeWeights[Section] - CumulativeWeights[Section - 1] : CumulativeWeights[Section];
+}
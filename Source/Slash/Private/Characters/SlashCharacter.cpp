@@ -11,6 +11,7 @@
 #include "Camera/CameraComponent.h"
 #include "GroomComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/FactionComponent.h"
 #include "Items/Item.h"
 #include "Items/Soul.h"
 #include "Items/Health.h"
@@ -19,10 +20,13 @@
 #include "Animation/AnimMontage.h"
 #include "HUD/SlashHUD.h"
 #include "HUD/SlashOverlay.h"
+#include "Combat/CombatEventSubsystem.h"
+#include "Replay/InputReplaySubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 ASlashCharacter::ASlashCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 	bUseControllerRotationPitch = false;
 	bUseControllerRotationRoll = false;
@@ -52,16 +56,9 @@ ASlashCharacter::ASlashCharacter()
 	Eyebrows->SetupAttachment(GetMesh());
 	Eyebrows->AttachmentName = FString("head");
 
-	AutoPossessPlayer = EAutoReceiveInput::Player0;
-}
+	Faction->SetFaction(EFaction::EF_Player);
 
-void ASlashCharacter::Tick(float DeltaTime)
-{
-	if (Attributes && SlashOverlay)
-	{
-		Attributes->RegenStamina(DeltaTime);
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
-	}
+	AutoPossessPlayer = EAutoReceiveInput::Player0;
 }
 
 void ASlashCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -78,9 +75,29 @@ void ASlashCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComp
 		EnhancedInputComponent->BindAction(DodgeAction, ETriggerEvent::Triggered, this, &ASlashCharacter::Dodge);
 		EnhancedInputComponent->BindAction(Equip1hAction, ETriggerEvent::Triggered, this, &ASlashCharacter::Num1KeyPressed);
 		EnhancedInputComponent->BindAction(Equip2hAction, ETriggerEvent::Triggered, this, &ASlashCharacter::Num2KeyPressed);
+
+		if (UInputReplaySubsystem* InputReplay = GetWorld()->GetSubsystem<UInputReplaySubsystem>())
+		{
+			UInputAction* const Actions[] = { MoveAction, LookAction, JumpAction, EKeyAction, AttackAction, DodgeAction, Equip1hAction, Equip2hAction };
+			InputReplay->RecordActions(EnhancedInputComponent, Actions);
+		}
 	}
 }
 
+void ASlashCharacter::ReplayInput(const UInputAction* Action, const FInputActionValue& Value)
+{
+	if (Action == nullptr) return;
+
+	if (Action == MoveAction) Move(Value);
+	else if (Action == LookAction) Look(Value);
+	else if (Action == JumpAction) Jump();
+	else if (Action == EKeyAction) EKeyPressed(Value);
+	else if (Action == AttackAction) Attack(Value);
+	else if (Action == DodgeAction) Dodge(Value);
+	else if (Action == Equip1hAction) Num1KeyPressed(Value);
+	else if (Action == Equip2hAction) Num2KeyPressed(Value);
+}
+
 void ASlashCharacter::Jump()
 {
 	if (IsUnoccupied())
@@ -89,20 +106,27 @@ void ASlashCharacter::Jump()
 	}
 }
 
-void ASlashCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
+void ASlashCharacter::PawnClientRestart()
 {
-	Super::GetHit_Implementation(ImpactPoint, Hitter);
+	Super::PawnClientRestart();
 
-	if (Attributes && Attributes->IsAlive()) 
-	{
-		ActionState = EActionState::EAS_HitReaction;
-	}
+	// Pawns spawned for network players are possessed after BeginPlay
+	InitializeLocalPlayer();
+}
+
+void ASlashCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ASlashCharacter, CharacterState);
+	DOREPLIFETIME(ASlashCharacter, ActiveWeapon);
+	DOREPLIFETIME_CONDITION(ASlashCharacter, ActionState, COND_SkipOwner);
 }
 
 float ASlashCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	HandleDamage(DamageAmount);
-	SetHUDHealth();
+	UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Damage, EventInstigator ? EventInstigator->GetPawn() : DamageCauser, this, DamageAmount, GetActorLocation());
 	return DamageAmount;
 }
 
@@ -113,22 +137,21 @@ void ASlashCharacter::SetOverlappingItem(AItem* Item)
 
 void ASlashCharacter::AddSouls(ASoul* Soul)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
 		Attributes->AddSouls(Soul->GetSouls());
-		SlashOverlay->SetSoulsCount(Attributes->GetSouls());
+		UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Pickup, this, Soul, Soul->GetSouls(), Soul->GetActorLocation());
 	}
 }
 
 bool ASlashCharacter::AddHealth(AHealth* Health)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
-		float CurrentHealth = Attributes->GetHealth();
-		if (CurrentHealth == 100.f) return false;
+		if (Attributes->IsFull(EAttributeId::EAI_Health)) return false;
 
 		Attributes->AddHealth(Health->GetHealth());
-		SetHUDHealth();
+		UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Pickup, this, Health, Health->GetHealth(), Health->GetActorLocation());
 		return true;
 	}
 
@@ -137,10 +160,10 @@ bool ASlashCharacter::AddHealth(AHealth* Health)
 
 void ASlashCharacter::AddGold(ATreasure* Treasure)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
 		Attributes->AddGold(Treasure->GetGold());
-		SlashOverlay->SetGoldCount(Attributes->GetGold());
+		UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Pickup, this, Treasure, Treasure->GetGold(), Treasure->GetActorLocation());
 	}
 }
 
@@ -148,17 +171,8 @@ void ASlashCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
-	{
-		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
-		{
-			Subsystem->AddMappingContext(SlashCharacterMappingContext, 0);
-		}
-
-		InitializeSlashOverlay(PlayerController);
-	}
-
-	Tags.Add(FName("EngageableTarget"));
+	InitializeLocalPlayer();
+	Faction->AddState(EFactionStateFlags::Engageable);
 }
 
 void ASlashCharacter::Move(const FInputActionValue& Value)
@@ -189,6 +203,12 @@ void ASlashCharacter::Look(const FInputActionValue& Value)
 
 void ASlashCharacter::EKeyPressed(const FInputActionValue& Value)
 {
+	if (!HasAuthority())
+	{
+		ServerEKeyPressed();
+		return;
+	}
+
 	if (!OverlappingItem) return;
 
 	AWeapon* OverlappingWeapon = Cast<AWeapon>(OverlappingItem);
@@ -200,6 +220,12 @@ void ASlashCharacter::EKeyPressed(const FInputActionValue& Value)
 
 void ASlashCharacter::Num1KeyPressed(const FInputActionValue& Value)
 {
+	if (!HasAuthority())
+	{
+		ServerNum1KeyPressed();
+		return;
+	}
+
 	if (CanDisarm1h())
 	{
 		Disarm();
@@ -217,6 +243,12 @@ void ASlashCharacter::Num1KeyPressed(const FInputActionValue& Value)
 
 void ASlashCharacter::Num2KeyPressed(const FInputActionValue& Value)
 {
+	if (!HasAuthority())
+	{
+		ServerNum2KeyPressed();
+		return;
+	}
+
 	if (CanDisarm2h())
 	{
 		Disarm();
@@ -238,16 +270,14 @@ void ASlashCharacter::Attack(const FInputActionValue& Value)
 
 	if (CanAttack())
 	{
-		if (ActiveWeapon->GetWeaponType() == "One-Handed")
-		{
-			PlayAttackMontage(AttackMontage_1h);
-		}
-		else if (ActiveWeapon->GetWeaponType() == "Two-Handed")
+		const int32 Section = PlayAttackMontage(GetAttackMontage());
+		ActionState = EActionState::EAS_Attacking;
+
+		// Clients attack right away, the server checks it could attack too and plays the same section
+		if (!HasAuthority())
 		{
-			PlayAttackMontage(AttackMontage_2h);
+			ServerAttack(Section);
 		}
-
-		ActionState = EActionState::EAS_Attacking;
 	}
 }
 
@@ -257,40 +287,125 @@ void ASlashCharacter::Dodge(const FInputActionValue& Value)
 
 	PlayDodgeMontage();
 	ActionState = EActionState::EAS_Dodge;
-	if (Attributes && SlashOverlay)
+
+	// Clients dodge right away, the stamina is spent by the server
+	if (!HasAuthority())
+	{
+		ServerDodge();
+		return;
+	}
+
+	UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Dodge, this, CombatTarget, 0.f, GetActorLocation());
+	if (Attributes)
 	{
 		Attributes->UseStamina(Attributes->GetDodgeCost());
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
 	}
 }
 
+void ASlashCharacter::ServerAttack_Implementation(int32 Section)
+{
+	Super::Attack();
+
+	// Only sections the server could have picked itself, a client can't play sections weighted out or past the end
+	UAnimMontage* AttackMontage = GetAttackMontage();
+	if (!CanAttack() || GetSectionCache(AttackMontage).GetSectionWeight(Section) <= 0.f)
+	{
+		ClientRejectAction(ActionState);
+		return;
+	}
+
+	PlayMontageSection(AttackMontage, Section);
+	MulticastPlayMontageSection(AttackMontage, Section);
+	ActionState = EActionState::EAS_Attacking;
+}
+
+void ASlashCharacter::ServerDodge_Implementation()
+{
+	if (IsOccupied() || !HasEnoughStamina())
+	{
+		ClientRejectAction(ActionState);
+		return;
+	}
+
+	Dodge(FInputActionValue());
+}
+
+void ASlashCharacter::ClientRejectAction_Implementation(EActionState ServerActionState)
+{
+	// Nothing to undo if the server has already replaced the prediction, e.g. with a hit react
+	if (ActionState != EActionState::EAS_Attacking && ActionState != EActionState::EAS_Dodge) return;
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.25f, AnimInstance->GetCurrentActiveMontage());
+	}
+	ActionState = ServerActionState;
+}
+
+void ASlashCharacter::ServerEKeyPressed_Implementation()
+{
+	EKeyPressed(FInputActionValue());
+}
+
+void ASlashCharacter::ServerNum1KeyPressed_Implementation()
+{
+	Num1KeyPressed(FInputActionValue());
+}
+
+void ASlashCharacter::ServerNum2KeyPressed_Implementation()
+{
+	Num2KeyPressed(FInputActionValue());
+}
+
+UAnimMontage* ASlashCharacter::GetAttackMontage() const
+{
+	const UWeaponDataAsset* WeaponData = ActiveWeapon ? ActiveWeapon->GetWeaponData() : nullptr;
+	if (WeaponData == nullptr) return nullptr;
+
+	if (WeaponData->AttackMontage)
+	{
+		return WeaponData->AttackMontage;
+	}
+
+	switch (WeaponData->WeaponType)
+	{
+	case EWeaponType::EWT_OneHanded:
+		return AttackMontage_1h;
+	case EWeaponType::EWT_TwoHanded:
+		return AttackMontage_2h;
+	}
+	return nullptr;
+}
+
 void ASlashCharacter::EquipWeapon(AWeapon* Weapon)
 {
-	Weapon->Equip(GetMesh(), FName("RightHandSocket"), this, this);
+	Weapon->Equip(GetMesh(), Weapon->GetWeaponData()->HandSocket, this, this);
 	Weapon->PlayEquipSound();
 	ActiveWeapon = Weapon;
 	OverlappingItem = nullptr;
 
-	FString WeaponType = Weapon->GetWeaponType();
-	if (WeaponType == "One-Handed")
+	switch (Weapon->GetWeaponType())
 	{
+	case EWeaponType::EWT_OneHanded:
 		CharacterState = ECharacterState::ECS_EquippedOneHandedWeapon;
 		Equipped1hWeapon = Weapon;
-	}
-	else if (WeaponType == "Two-Handed")
-	{
+		break;
+	case EWeaponType::EWT_TwoHanded:
 		CharacterState = ECharacterState::ECS_EquippedTwoHandedWeapon;
 		Equipped2hWeapon = Weapon;
+		break;
 	}
 }
 
-void ASlashCharacter::PlayEquipMontage(const FName& SectionName, UAnimMontage* EquipMontage)
+void ASlashCharacter::PlayEquipMontage(EEquipMontageSection Section, UAnimMontage* EquipMontage)
 {
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance && EquipMontage)
+	// Indexed by EEquipMontageSection
+	static const FName EquipSectionNames[] = { FName("Equip"), FName("Unequip") };
+	static_assert(UE_ARRAY_COUNT(EquipSectionNames) == static_cast<int32>(EEquipMontageSection::EEM_MAX));
+
+	if (EquipMontage)
 	{
-		AnimInstance->Montage_Play(EquipMontage);
-		AnimInstance->Montage_JumpToSection(SectionName, EquipMontage);
+		PlayMontageSection(EquipMontage, GetSectionCache(EquipMontage, EquipSectionNames).GetSlotSection(static_cast<int32>(Section)));
 	}
 }
 
@@ -342,28 +457,33 @@ bool ASlashCharacter::CanArm2h()
 
 void ASlashCharacter::Arm()
 {
-	ActionState = EActionState::EAS_EquippingWeapon;
-	if (CharacterState == ECharacterState::ECS_EquippedOneHandedWeapon)
-	{
-		PlayEquipMontage(FName("Equip"), EquipMontage_1h);
-	}
-	else if (CharacterState == ECharacterState::ECS_EquippedTwoHandedWeapon)
-	{
-		PlayEquipMontage(FName("Equip"), EquipMontage_2h);
-	}
+	MulticastPlayEquipMontage(EEquipMontageSection::EEM_Equip, GetEquipMontage());
 }
 
 void ASlashCharacter::Disarm()
+{
+	MulticastPlayEquipMontage(EEquipMontageSection::EEM_Unequip, GetEquipMontage());
+}
+
+void ASlashCharacter::MulticastPlayEquipMontage_Implementation(EEquipMontageSection Section, UAnimMontage* EquipMontage)
 {
 	ActionState = EActionState::EAS_EquippingWeapon;
+	PlayEquipMontage(Section, EquipMontage);
+}
+
+UAnimMontage* ASlashCharacter::GetEquipMontage() const
+{
 	if (CharacterState == ECharacterState::ECS_EquippedOneHandedWeapon)
 	{
-		PlayEquipMontage(FName("Unequip"), EquipMontage_1h);
+		UAnimMontage* WeaponMontage = Equipped1hWeapon ? Equipped1hWeapon->GetWeaponData()->EquipMontage : nullptr;
+		return WeaponMontage ? WeaponMontage : EquipMontage_1h;
 	}
-	else if (CharacterState == ECharacterState::ECS_EquippedTwoHandedWeapon)
+	if (CharacterState == ECharacterState::ECS_EquippedTwoHandedWeapon)
 	{
-		PlayEquipMontage(FName("Unequip"), EquipMontage_2h);
+		UAnimMontage* WeaponMontage = Equipped2hWeapon ? Equipped2hWeapon->GetWeaponData()->EquipMontage : nullptr;
+		return WeaponMontage ? WeaponMontage : EquipMontage_2h;
 	}
+	return nullptr;
 }
 
 void ASlashCharacter::Die_Implementation()
@@ -374,6 +494,24 @@ void ASlashCharacter::Die_Implementation()
 	DisableMeshCollision();
 }
 
+void ASlashCharacter::MulticastHitReact_Implementation(EHitReactDirection Direction)
+{
+	Super::MulticastHitReact_Implementation(Direction);
+
+	ActionState = EActionState::EAS_HitReaction;
+}
+
+void ASlashCharacter::OnRep_DeathPose()
+{
+	Super::OnRep_DeathPose();
+
+	if (DeathPose < EDeathPose::EDP_MAX)
+	{
+		ActionState = EActionState::EAS_Dead;
+		DisableMeshCollision();
+	}
+}
+
 bool ASlashCharacter::HasEnoughStamina()
 {
 	return Attributes && Attributes->GetStamina() >= Attributes->GetDodgeCost();
@@ -388,13 +526,19 @@ void ASlashCharacter::AttachWeaponToHand()
 {
 	if (CharacterState == ECharacterState::ECS_EquippedOneHandedWeapon)
 	{
-		Equipped1hWeapon->Equip(GetMesh(), FName("RightHandSocket"), this, this);
-		ActiveWeapon = Equipped1hWeapon;
+		Equipped1hWeapon->Equip(GetMesh(), Equipped1hWeapon->GetWeaponData()->HandSocket, this, this);
+		if (HasAuthority())
+		{
+			ActiveWeapon = Equipped1hWeapon;
+		}
 	} 
 	else if (CharacterState == ECharacterState::ECS_EquippedTwoHandedWeapon)
 	{
-		Equipped2hWeapon->Equip(GetMesh(), FName("RightHandSocket"), this, this);
-		ActiveWeapon = Equipped2hWeapon;
+		Equipped2hWeapon->Equip(GetMesh(), Equipped2hWeapon->GetWeaponData()->HandSocket, this, this);
+		if (HasAuthority())
+		{
+			ActiveWeapon = Equipped2hWeapon;
+		}
 	}
 }
 
@@ -402,14 +546,19 @@ void ASlashCharacter::AttachWeaponToScabbard()
 {
 	if (CharacterState == ECharacterState::ECS_EquippedOneHandedWeapon)
 	{
-		Equipped1hWeapon->Unequip(GetMesh(), FName("ThighSocket"));
+		Equipped1hWeapon->Unequip(GetMesh(), Equipped1hWeapon->GetWeaponData()->SheathSocket);
 	}
 	else if (CharacterState == ECharacterState::ECS_EquippedTwoHandedWeapon)
 	{
-		Equipped2hWeapon->Unequip(GetMesh(), FName("NeckSocket"));
+		Equipped2hWeapon->Unequip(GetMesh(), Equipped2hWeapon->GetWeaponData()->SheathSocket);
+	}
+
+	// The notify fires on every machine, the replicated state is only the server's to change
+	if (HasAuthority())
+	{
+		CharacterState = ECharacterState::ECS_Unequipped;
+		ActiveWeapon = nullptr;
 	}
-	CharacterState = ECharacterState::ECS_Unequipped;
-	ActiveWeapon = nullptr;
 }
 
 void ASlashCharacter::FinishEquipping()
@@ -427,25 +576,30 @@ bool ASlashCharacter::IsUnoccupied()
 	return ActionState == EActionState::EAS_Unoccupied;
 }
 
+void ASlashCharacter::InitializeLocalPlayer()
+{
+	APlayerController* PlayerController = Cast<APlayerController>(GetController());
+	if (PlayerController == nullptr || !PlayerController->IsLocalController()) return;
+
+	if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()))
+	{
+		Subsystem->AddMappingContext(SlashCharacterMappingContext, 0);
+	}
+
+	InitializeSlashOverlay(PlayerController);
+}
+
 void ASlashCharacter::InitializeSlashOverlay(APlayerController* PlayerController)
 {
+	// Already bound when BeginPlay had a controller
+	if (SlashOverlay) return;
+
 	if (ASlashHUD* SlashHUD = Cast<ASlashHUD>(PlayerController->GetHUD()))
 	{
 		SlashOverlay = SlashHUD->GetSlashOverlay();
 		if (SlashOverlay && Attributes)
 		{
-			SlashOverlay->SetHealthBarPercent(Attributes->GetHealthPercent());
-			SlashOverlay->SetStaminaBarPercent(1.f);
-			SlashOverlay->SetGoldCount(0);
-			SlashOverlay->SetSoulsCount(0);
+			SlashOverlay->BindAttributes(Attributes);
 		}
 	}
 }
-
-void ASlashCharacter::SetHUDHealth()
-{
-	if (SlashOverlay && Attributes)
-	{
-		SlashOverlay->SetHealthBarPercent(Attributes->GetHealthPercent());
-	}
-}
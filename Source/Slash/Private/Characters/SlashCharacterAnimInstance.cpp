@@ -4,7 +4,7 @@
 #include "Characters/SlashCharacterAnimInstance.h"
 #include "Characters/SlashCharacter.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Slash/SlashStats.h"
 
 void USlashCharacterAnimInstance::NativeInitializeAnimation()
 {
@@ -19,14 +19,26 @@ void USlashCharacterAnimInstance::NativeInitializeAnimation()
 
 void USlashCharacterAnimInstance::NativeUpdateAnimation(float DeltaTime)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashAnimSnapshot);
 	Super::NativeUpdateAnimation(DeltaTime);
 
 	if (SlashCharacterMovement)
 	{
-		GroundSpeed = UKismetMathLibrary::VSizeXY(SlashCharacterMovement->Velocity);
-		IsFalling = SlashCharacterMovement->IsFalling();
-		CharacterState = SlashCharacter->GetCharacterState();
-		ActionState = SlashCharacter->GetActionState();
-		DeathPose = SlashCharacter->GetDeathPose();
+		Snapshot.Velocity = SlashCharacterMovement->Velocity;
+		Snapshot.bIsFalling = SlashCharacterMovement->IsFalling();
+		Snapshot.CharacterState = SlashCharacter->GetCharacterState();
+		Snapshot.ActionState = SlashCharacter->GetActionState();
+		Snapshot.DeathPose = SlashCharacter->GetDeathPose();
 	}
 }
+
+void USlashCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaTime);
+
+	GroundSpeed = Snapshot.Velocity.Size2D();
+	IsFalling = Snapshot.bIsFalling;
+	CharacterState = Snapshot.CharacterState;
+	ActionState = Snapshot.ActionState;
+	DeathPose = Snapshot.DeathPose;
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/BladeSweep.h"
+
+namespace
+{
+	/** Below this the pivot is too far away to matter and the socket is simply lerped */
+	constexpr double MinScrewAngle = 1.0e-4;
+}
+
+void FBladeSweep::SetFrame(const FTransform& InFrom, const FTransform& InTo)
+{
+	From = InFrom;
+	To = InTo;
+
+	FQuat Delta = To.GetRotation() * From.GetRotation().Inverse();
+	if (Delta.W < 0.0)
+	{
+		Delta = -Delta;
+	}
+	Delta.Normalize();
+	Delta.ToAxisAndAngle(Axis, Angle);
+
+	const FVector Travel = To.GetLocation() - Delta.RotateVector(From.GetLocation());
+	AxialTravel = Axis * FVector::DotProduct(Travel, Axis);
+	if (Angle < MinScrewAngle)
+	{
+		Pivot = FVector::ZeroVector;
+		return;
+	}
+
+	// The point on the axis that the rotation alone carries the rest of the travel around
+	const FVector RadialTravel = Travel - AxialTravel;
+	Pivot = 0.5 * (RadialTravel + FVector::CrossProduct(Axis, RadialTravel) / FMath::Tan(0.5 * Angle));
+}
+
+int32 FBladeSweep::GetNumSubsteps(double MaxStepDistance) const
+{
+	const FVector Scale = From.GetScale3D();
+	double Travel;
+	if (Angle < MinScrewAngle)
+	{
+		const double Radius = FMath::Max((Scale * LocalStart.GetLocation()).Size(), (Scale * LocalEnd).Size());
+		Travel = FVector::Dist(From.GetLocation(), To.GetLocation()) + Angle * Radius;
+	}
+	else
+	{
+		// Every point of the blade is at most as far from the axis as one of its ends
+		const FVector ToStart = From.TransformPosition(LocalStart.GetLocation()) - Pivot;
+		const FVector ToEnd = From.TransformPosition(LocalEnd) - Pivot;
+		const double Radius = FMath::Max(
+			(ToStart - Axis * FVector::DotProduct(ToStart, Axis)).Size(),
+			(ToEnd - Axis * FVector::DotProduct(ToEnd, Axis)).Size()
+		);
+		Travel = AxialTravel.Size() + Angle * Radius;
+	}
+
+	return FMath::Max(FMath::CeilToInt32(Travel / FMath::Max(MaxStepDistance, UE_KINDA_SMALL_NUMBER)), 1);
+}
+
+void FBladeSweep::GetPose(double Alpha, FVector& OutStart, FVector& OutEnd, FQuat& OutRotation) const
+{
+	FTransform Socket;
+	if (Angle < MinScrewAngle)
+	{
+		Socket = FTransform(
+			FQuat::Slerp(From.GetRotation(), To.GetRotation(), Alpha),
+			FMath::Lerp(From.GetLocation(), To.GetLocation(), Alpha),
+			From.GetScale3D()
+		);
+	}
+	else
+	{
+		const FQuat Turn(Axis, Angle * Alpha);
+		Socket = FTransform(
+			Turn * From.GetRotation(),
+			Pivot + Turn.RotateVector(From.GetLocation() - Pivot) + AxialTravel * Alpha,
+			From.GetScale3D()
+		);
+	}
+
+	const FTransform Start = LocalStart * Socket;
+	OutStart = Start.GetLocation();
+	OutRotation = Start.GetRotation();
+	OutEnd = Socket.TransformPosition(LocalEnd);
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/CombatEventSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<bool> CVarCombatLogEnabled(
+	TEXT("Slash.CombatLog.Enabled"),
+	true,
+	TEXT("Write combat events (hits, damage, deaths, dodges, pickups) to a binary log in Saved/Logs.\n")
+	TEXT("Read when a world starts."),
+	ECVF_Default);
+
+void UCombatEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (CVarCombatLogEnabled.GetValueOnGameThread())
+	{
+		const FString Filename = FPaths::ProjectLogDir() / FString::Printf(TEXT("CombatEvents-%s.bin"), *FDateTime::Now().ToString());
+		Writer = MakeUnique<FCombatEventWriter>(Filename);
+	}
+}
+
+void UCombatEventSubsystem::Deinitialize()
+{
+	if (Writer)
+	{
+		Writer->Shutdown();
+		Writer->LogSummary();
+		Writer.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UCombatEventSubsystem::RecordEvent(ECombatEventType Type, const AActor* Attacker, const AActor* Victim, float Amount, const FVector& Location)
+{
+	if (Writer == nullptr) return;
+
+	checkSlow(IsInGameThread());
+
+	FCombatEvent Event;
+	Event.Frame = GFrameCounter;
+	Event.Location = FVector3f(Location);
+	Event.Amount = Amount;
+	Event.AttackerId = Attacker ? Attacker->GetUniqueID() : 0;
+	Event.VictimId = Victim ? Victim->GetUniqueID() : 0;
+	Event.Type = Type;
+	Writer->Enqueue(Event);
+}
+
+void UCombatEventSubsystem::Record(const UObject* WorldContextObject, ECombatEventType Type, const AActor* Attacker, const AActor* Victim, float Amount, const FVector& Location)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (UCombatEventSubsystem* CombatEvents = World ? World->GetSubsystem<UCombatEventSubsystem>() : nullptr)
+	{
+		CombatEvents->RecordEvent(Type, Attacker, Victim, Amount, Location);
+	}
+}
+
+bool UCombatEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
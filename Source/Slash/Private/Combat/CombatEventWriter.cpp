@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/CombatEventWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Slash.h"
+
+FCombatEventWriter::FCombatEventWriter(const FString& InFilename)
+	: Filename(InFilename)
+{
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (FileWriter)
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		*FileWriter << Magic << Version;
+	}
+	else
+	{
+		UE_LOG(LogSlash, Warning, TEXT("CombatLog: could not open %s, events will only be aggregated"), *Filename);
+	}
+
+	Thread = FRunnableThread::Create(this, TEXT("CombatEventWriter"), 0, TPri_BelowNormal);
+}
+
+FCombatEventWriter::~FCombatEventWriter()
+{
+	Shutdown();
+}
+
+bool FCombatEventWriter::Enqueue(const FCombatEvent& Event)
+{
+	if (Events.Push(Event)) return true;
+
+	++NumDropped;
+	return false;
+}
+
+void FCombatEventWriter::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	Drain();
+
+	if (FileWriter)
+	{
+		FileWriter->Close();
+		FileWriter.Reset();
+	}
+}
+
+uint32 FCombatEventWriter::Run()
+{
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		Drain();
+		FPlatformProcess::SleepNoStats(0.005f);
+	}
+	return 0;
+}
+
+void FCombatEventWriter::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+}
+
+void FCombatEventWriter::LogSummary() const
+{
+	static const TCHAR* EventNames[] = { TEXT("hits"), TEXT("damage"), TEXT("deaths"), TEXT("dodges"), TEXT("pickups") };
+	static_assert(UE_ARRAY_COUNT(EventNames) == static_cast<int32>(ECombatEventType::ECE_MAX), "Missing combat event name");
+
+	for (int32 Type = 0; Type < static_cast<int32>(ECombatEventType::ECE_MAX); ++Type)
+	{
+		UE_LOG(LogSlash, Display, TEXT("CombatLog: %-8s %6u events, total amount %.1f"), EventNames[Type], EventCounts[Type], EventAmounts[Type]);
+	}
+	UE_LOG(LogSlash, Display, TEXT("CombatLog: %u events dropped, written to %s"), NumDropped, *Filename);
+}
+
+void FCombatEventWriter::Drain()
+{
+	FCombatEvent Event;
+	while (Events.Pop(Event))
+	{
+		const int32 Type = static_cast<int32>(Event.Type);
+		++EventCounts[Type];
+		EventAmounts[Type] += Event.Amount;
+
+		if (FileWriter)
+		{
+			WriteEvent(Event);
+		}
+	}
+}
+
+void FCombatEventWriter::WriteEvent(const FCombatEvent& Event)
+{
+	FArchive& Ar = *FileWriter;
+
+	uint64 Frame = Event.Frame;
+	uint8 Type = static_cast<uint8>(Event.Type);
+	uint32 AttackerId = Event.AttackerId;
+	uint32 VictimId = Event.VictimId;
+	float Amount = Event.Amount;
+	FVector3f Location = Event.Location;
+
+	Ar << Frame << Type << AttackerId << VictimId << Amount << Location.X << Location.Y << Location.Z;
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/CombatTraceSubsystem.h"
+#include "Items/Weapons/Weapon.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<bool> CVarCombatAsyncTraces(
+	TEXT("Slash.Combat.AsyncTraces"),
+	true,
+	TEXT("Run weapon sweeps as async traces resolved on the next frame instead of synchronously on the game thread."),
+	ECVF_Default);
+
+void UCombatTraceSubsystem::Tick(float DeltaTime)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashCombatTraces);
+	if (InFlightSweeps.Num() > 0)
+	{
+		ResolveSweeps();
+	}
+}
+
+TStatId UCombatTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatTraceSubsystem::QueueWeaponSweep(AWeapon* Weapon, uint32 SwingId, const FVector& Start, const FVector& End, const FQuat& Rotation, const FVector& HalfExtent, const FCollisionObjectQueryParams& ObjectParams, const FCollisionQueryParams& QueryParams)
+{
+	const FTraceHandle Handle = GetWorld()->AsyncSweepByObjectType(
+		EAsyncTraceType::Multi,
+		Start,
+		End,
+		Rotation,
+		ObjectParams,
+		FCollisionShape::MakeBox(HalfExtent),
+		QueryParams
+	);
+
+	InFlightSweeps.Add({ Weapon, SwingId, Handle, GFrameCounter });
+}
+
+bool UCombatTraceSubsystem::IsAsyncEnabled()
+{
+	return CVarCombatAsyncTraces.GetValueOnGameThread();
+}
+
+bool UCombatTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatTraceSubsystem::ResolveSweeps()
+{
+	UWorld* World = GetWorld();
+
+	// Resolving applies damage, which may queue new sweeps
+	Swap(ResolvingSweeps, InFlightSweeps);
+
+	for (const FInFlightSweep& Sweep : ResolvingSweeps)
+	{
+		// Sweeps queued this frame only run once the frame ends
+		if (Sweep.FrameQueued >= GFrameCounter)
+		{
+			InFlightSweeps.Add(Sweep);
+			continue;
+		}
+
+		if (World->QueryTraceData(Sweep.Handle, TraceData))
+		{
+			if (AWeapon* Weapon = Sweep.Weapon.Get())
+			{
+				Weapon->ResolveSweepHits(Sweep.SwingId, TraceData.OutHits);
+			}
+		}
+		else if (GFrameCounter - Sweep.FrameQueued <= 1)
+		{
+			InFlightSweeps.Add(Sweep);
+		}
+	}
+
+	ResolvingSweeps.Reset();
+}
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/HitDirectionClassifier.h"
+#include "HAL/IConsoleManager.h"
+#include "Slash.h"
+
+namespace
+{
+	// Indexed by (Front << 2) | (Back << 1) | Negative, front and back are never both set
+	constexpr EHitReactDirection DirectionTable[8] =
+	{
+		EHitReactDirection::EHR_FromRight,
+		EHitReactDirection::EHR_FromLeft,
+		EHitReactDirection::EHR_FromBack,
+		EHitReactDirection::EHR_FromBack,
+		EHitReactDirection::EHR_FromFront,
+		EHitReactDirection::EHR_FromFront,
+		EHitReactDirection::EHR_FromFront,
+		EHitReactDirection::EHR_FromFront
+	};
+
+	FORCEINLINE EHitReactDirection ClassifyOne(const FVector& Forward, const FVector& Location, const FVector& HitFrom)
+	{
+		// The hit is lowered to the victim, so only the horizontal parts take part
+		const double ToHitX = HitFrom.X - Location.X;
+		const double ToHitY = HitFrom.Y - Location.Y;
+		const double SizeSquared = ToHitX * ToHitX + ToHitY * ToHitY;
+		const double Dot = Forward.X * ToHitX + Forward.Y * ToHitY;
+		const double Cross = Forward.X * ToHitY - Forward.Y * ToHitX;
+
+		// |cos(theta)| >= cos(45) <=> Dot^2 >= Size^2 / 2. Ties go where the angle thresholds put them:
+		// exactly -45 is front, +45 is right, 135 is back and -135 is left
+		const double Threshold = 0.5 * SizeSquared;
+		const double DotSquared = Dot * Dot;
+		const uint32 bValid = SizeSquared >= UE_SMALL_NUMBER; // GetSafeNormal returns zero below this, which is 90 degrees
+		const uint32 bNegative = bValid & (Cross < 0.0);
+		const uint32 bBeyond = DotSquared > Threshold;
+		const uint32 bOnEdge = DotSquared >= Threshold;
+		const uint32 bFront = bValid & (Dot > 0.0) & (bBeyond | (bNegative & bOnEdge));
+		const uint32 bBack = bValid & (Dot < 0.0) & (bBeyond | ((bNegative ^ 1u) & bOnEdge));
+
+		return DirectionTable[(bFront << 2) | (bBack << 1) | bNegative];
+	}
+}
+
+EHitReactDirection FHitDirectionClassifier::Classify(const FVector& Forward, const FVector& Location, const FVector& HitFrom)
+{
+	return ClassifyOne(Forward, Location, HitFrom);
+}
+
+void FHitDirectionClassifier::ClassifyBatch(TArrayView<const FVector> Forwards, TArrayView<const FVector> Locations, TArrayView<const FVector> HitFroms, TArrayView<EHitReactDirection> OutDirections)
+{
+	check(Forwards.Num() == Locations.Num() && Locations.Num() == HitFroms.Num() && HitFroms.Num() == OutDirections.Num());
+
+	for (int32 Index = 0; Index < OutDirections.Num(); ++Index)
+	{
+		OutDirections[Index] = ClassifyOne(Forwards[Index], Locations[Index], HitFroms[Index]);
+	}
+}
+
+EHitReactDirection FHitDirectionClassifier::ClassifyByAngle(const FVector& Forward, const FVector& Location, const FVector& HitFrom)
+{
+	const FVector HitLowered(HitFrom.X, HitFrom.Y, Location.Z);
+	const FVector ToHit = (HitLowered - Location).GetSafeNormal();
+
+	double Theta = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(Forward, ToHit)));
+	if (FVector::CrossProduct(Forward, ToHit).Z < 0)
+	{
+		Theta *= -1.f;
+	}
+
+	if (Theta >= -45.f && Theta < 45.f) return EHitReactDirection::EHR_FromFront;
+	if (Theta >= -135.f && Theta < -45.f) return EHitReactDirection::EHR_FromLeft;
+	if (Theta >= 45.f && Theta < 135.f) return EHitReactDirection::EHR_FromRight;
+	return EHitReactDirection::EHR_FromBack;
+}
+
+/**
+ * Classifies random hits around random victims with both paths, a cleave sized batch and a large one,
+ * and reports the time per hit and every hit the two paths disagree on. Quadrant edges are included.
+ */
+static void RunHitDirectionBenchmark(const TArray<FString>& Args)
+{
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+	const int32 BatchSizes[] = { 20, 10000 };
+
+	for (const int32 NumHits : BatchSizes)
+	{
+		FRandomStream Stream(NumHits);
+		TArray<FVector> Forwards;
+		TArray<FVector> Locations;
+		TArray<FVector> HitFroms;
+		for (int32 Index = 0; Index < NumHits; ++Index)
+		{
+			const double Yaw = Stream.FRandRange(0.0, 360.0);
+			const FVector Location(Stream.FRandRange(-5000.0, 5000.0), Stream.FRandRange(-5000.0, 5000.0), Stream.FRandRange(0.0, 500.0));
+			const double HitYaw = Index % 8 == 0 ? Yaw + 45.0 * Stream.RandRange(-4, 4) : Stream.FRandRange(0.0, 360.0);
+			const double HitDistance = Index % 64 == 0 ? 0.0 : Stream.FRandRange(10.0, 500.0);
+
+			Forwards.Add(FRotator(0.0, Yaw, 0.0).Vector());
+			Locations.Add(Location);
+			HitFroms.Add(Location + FRotator(0.0, HitYaw, 0.0).Vector() * HitDistance + FVector(0.0, 0.0, Stream.FRandRange(-100.0, 100.0)));
+		}
+
+		TArray<EHitReactDirection> ByAngle;
+		ByAngle.SetNumUninitialized(NumHits);
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (int32 Index = 0; Index < NumHits; ++Index)
+			{
+				ByAngle[Index] = FHitDirectionClassifier::ClassifyByAngle(Forwards[Index], Locations[Index], HitFroms[Index]);
+			}
+		}
+		const double ByAngleMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		TArray<EHitReactDirection> Batched;
+		Batched.SetNumUninitialized(NumHits);
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FHitDirectionClassifier::ClassifyBatch(Forwards, Locations, HitFroms, Batched);
+		}
+		const double BatchedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		int32 Mismatches = 0;
+		int32 EdgeTies = 0;
+		for (int32 Index = 0; Index < NumHits; ++Index)
+		{
+			if (ByAngle[Index] != Batched[Index])
+			{
+				// Hits that land on a quadrant edge to within rounding may go either way in both paths
+				const FVector ToHit = HitFroms[Index] - Locations[Index];
+				const double Theta = FMath::RadiansToDegrees(FMath::Atan2(Forwards[Index].X * ToHit.Y - Forwards[Index].Y * ToHit.X, Forwards[Index].X * ToHit.X + Forwards[Index].Y * ToHit.Y));
+				const double Wrapped = FMath::Fmod(FMath::Abs(Theta) + 45.0, 90.0); // 0 at +-45 and +-135
+				if (FMath::Min(Wrapped, 90.0 - Wrapped) < 1.0e-6)
+				{
+					++EdgeTies;
+					continue;
+				}
+
+				++Mismatches;
+				UE_LOG(LogSlash, Warning, TEXT("HitDirection mismatch: forward %s location %s hit %s, angle %d, batch %d"),
+					*Forwards[Index].ToString(), *Locations[Index].ToString(), *HitFroms[Index].ToString(),
+					static_cast<int32>(ByAngle[Index]), static_cast<int32>(Batched[Index]));
+			}
+		}
+
+		const double NumClassified = static_cast<double>(NumHits) * Iterations;
+		UE_LOG(LogSlash, Display, TEXT("HitDirection %5d hits x %d: angles %8.3f ms (%6.2f ns/hit) | batch %8.3f ms (%6.2f ns/hit) | mismatches %d, edge ties %d"),
+			NumHits, Iterations,
+			ByAngleMs, ByAngleMs * 1.0e6 / NumClassified,
+			BatchedMs, BatchedMs * 1.0e6 / NumClassified,
+			Mismatches, EdgeTies);
+	}
+}
+
+static FAutoConsoleCommand HitDirectionBenchmarkCommand(
+	TEXT("Slash.Bench.HitDirection"),
+	TEXT("Benchmarks hit react direction selection, Acos thresholds vs batched sign tests, and checks both agree. Optional arg: iterations."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunHitDirectionBenchmark));
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/SwingHitRegistry.h"
+
+void FSwingHitRegistry::BeginSwing(int32 InMaxTargets, float InHitCooldown)
+{
+	LastHitTimes.Reset();
+	++SwingId;
+	MaxTargets = InMaxTargets;
+	HitCooldown = InHitCooldown;
+}
+
+bool FSwingHitRegistry::TryRegisterHit(AActor* Target, float Time)
+{
+	if (Target == nullptr) return false;
+
+	if (float* LastHitTime = LastHitTimes.Find(Target))
+	{
+		if (!AllowsRehits() || Time - *LastHitTime < HitCooldown) return false;
+
+		*LastHitTime = Time;
+		return true;
+	}
+
+	if (IsCleaveExhausted()) return false;
+
+	LastHitTimes.Add(Target, Time);
+	return true;
+}
+
+bool FSwingHitRegistry::IsCleaveExhausted() const
+{
+	return MaxTargets > 0 && LastHitTimes.Num() >= MaxTargets;
+}
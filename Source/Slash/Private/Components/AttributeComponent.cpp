@@ -2,66 +2,477 @@
 
 
 #include "Components/AttributeComponent.h"
+#include "Components/AttributeRegenSubsystem.h"
+#include "Components/FactionComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+/** Small steps are held back until they add up, but empty and full always go through */
+static bool PercentChanged(float Percent, float BroadcastPercent, float Tolerance)
+{
+	if (Percent == BroadcastPercent) return false;
+	return Percent <= 0.f || Percent >= 1.f || !FMath::IsNearlyEqual(Percent, BroadcastPercent, Tolerance);
+}
+
+/** Used when neither the attribute set nor the overrides define an attribute */
+static FAttributeDefinition GetFallbackDefinition(EAttributeId Id)
+{
+	const float MaxCount = static_cast<float>(TNumericLimits<int32>::Max());
+	switch (Id)
+	{
+	case EAttributeId::EAI_Health:
+		return FAttributeDefinition(0.f, 100.f, 100.f, 0.f);
+	case EAttributeId::EAI_Stamina:
+		return FAttributeDefinition(0.f, 100.f, 100.f, 3.f);
+	case EAttributeId::EAI_DodgeCost:
+		return FAttributeDefinition(0.f, 100.f, 15.f, 0.f);
+	default:
+		return FAttributeDefinition(0.f, MaxCount, 0.f, 0.f);
+	}
+}
 
 UAttributeComponent::UAttributeComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Only ticks on frames with changes to broadcast
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+
+	bWantsInitializeComponent = true;
+	SetIsReplicatedByDefault(true);
 }
 
+void UAttributeComponent::PostLoad()
+{
+	Super::PostLoad();
+
+	MigrateDeprecatedAttributes();
+}
+
+void UAttributeComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST_STATIC_ARRAY(UAttributeComponent, Values, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST_STATIC_ARRAY(UAttributeComponent, Maxes, Params);
+}
+
+void UAttributeComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	ResolveDefinitions();
+	EvaluateModifiers();
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		Values[Index] = Definitions[Index].Default;
+		Maxes[Index] = EffectiveMax[Index];
+	}
+}
 
 void UAttributeComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Clients receive regenerated values from the server
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		RegenSubsystem = GetWorld()->GetSubsystem<UAttributeRegenSubsystem>();
+		Faction = UFactionComponent::Find(GetOwner());
+		UpdateRegenActivation();
+	}
+}
+
+void UAttributeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (RegenSubsystem)
+	{
+		RegenSubsystem->Deactivate(this);
+		RegenSubsystem = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UAttributeComponent::ResolveDefinitions()
+{
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		const EAttributeId Id = static_cast<EAttributeId>(Index);
+		// Per-instance overrides win, migrated values included, so assigning a set doesn't shadow them
+		const FAttributeDefinition* Definition = AttributeOverrides.Find(Id);
+		if (Definition == nullptr && AttributeSet)
+		{
+			Definition = AttributeSet->Definitions.Find(Id);
+		}
+		Definitions[Index] = Definition ? *Definition : GetFallbackDefinition(Id);
+	}
+	bModifiersDirty = true;
+}
+
+void UAttributeComponent::MigrateDeprecatedAttributes()
+{
+	// Components saved before attribute sets kept each attribute in its own property
+	if (MaxHealth_DEPRECATED > 0.f)
+	{
+		AttributeOverrides.Add(EAttributeId::EAI_Health, FAttributeDefinition(0.f, MaxHealth_DEPRECATED, Health_DEPRECATED, 0.f));
+		MaxHealth_DEPRECATED = 0.f;
+	}
+
+	if (MaxStamina_DEPRECATED > 0.f)
+	{
+		AttributeOverrides.Add(EAttributeId::EAI_Stamina, FAttributeDefinition(0.f, MaxStamina_DEPRECATED, Stamina_DEPRECATED, StaminaRegenRate_DEPRECATED));
+		MaxStamina_DEPRECATED = 0.f;
+	}
+
+	const float MaxCount = static_cast<float>(TNumericLimits<int32>::Max());
+	if (Gold_DEPRECATED != 0)
+	{
+		AttributeOverrides.Add(EAttributeId::EAI_Gold, FAttributeDefinition(0.f, MaxCount, Gold_DEPRECATED, 0.f));
+		Gold_DEPRECATED = 0;
+	}
+
+	if (Souls_DEPRECATED != 0)
+	{
+		AttributeOverrides.Add(EAttributeId::EAI_Souls, FAttributeDefinition(0.f, MaxCount, Souls_DEPRECATED, 0.f));
+		Souls_DEPRECATED = 0;
+	}
+
+	if (DodgeCost_DEPRECATED != 15)
+	{
+		AttributeOverrides.Add(EAttributeId::EAI_DodgeCost, FAttributeDefinition(0.f, 100.f, DodgeCost_DEPRECATED, 0.f));
+		DodgeCost_DEPRECATED = 15;
+	}
+}
+
+float UAttributeComponent::GetMax(EAttributeId Id) const
+{
+	// Clients have no modifiers to evaluate
+	if (IsNetSimulating()) return Maxes[static_cast<int32>(Id)];
+
+	if (bModifiersDirty) EvaluateModifiers();
+	return EffectiveMax[static_cast<int32>(Id)];
+}
+
+float UAttributeComponent::GetRegenRate(EAttributeId Id) const
+{
+	if (bModifiersDirty) EvaluateModifiers();
+	return EffectiveRegen[static_cast<int32>(Id)];
+}
+
+float UAttributeComponent::GetPercent(EAttributeId Id) const
+{
+	const float Max = GetMax(Id);
+	return Max > 0.f ? GetValue(Id) / Max : 0.f;
+}
+
+void UAttributeComponent::SetValue(EAttributeId Id, float NewValue)
+{
+	const int32 Index = static_cast<int32>(Id);
+	NewValue = FMath::Clamp(NewValue, Definitions[Index].Min, GetMax(Id));
+	if (NewValue == Values[Index]) return;
+
+	Values[Index] = NewValue;
+	MarkValueDirty(Index);
+
+	if (RegenSubsystem == nullptr) return;
+
+	if (IsOwnerDead())
+	{
+		RegenSubsystem->Deactivate(this);
+	}
+	else if (RegenIndex == INDEX_NONE && NeedsRegen(Id))
+	{
+		RegenSubsystem->Activate(this);
+	}
+}
+
+int32 UAttributeComponent::AddModifier(EAttributeId Attribute, EAttributeModifierTarget Target, EAttributeModifierOp Op, float Magnitude)
+{
+	const int32 Handle = NextModifierHandle++;
+	Modifiers.Add({ Handle, Attribute, Target, Op, Magnitude });
+	bModifiersDirty = true;
+	UpdateReplicatedMax(Attribute);
+
+	// A lower max takes effect right away, the value is clamped to it
+	SetValue(Attribute, GetValue(Attribute));
+	MarkDirty(Attribute);
+	UpdateRegenActivation();
+	return Handle;
+}
+
+void UAttributeComponent::RemoveModifier(int32 Handle)
+{
+	const int32 Index = Modifiers.IndexOfByPredicate([Handle](const FAttributeModifier& Modifier) { return Modifier.Handle == Handle; });
+	if (Index == INDEX_NONE) return;
+
+	const EAttributeId Attribute = Modifiers[Index].Attribute;
+	Modifiers.RemoveAtSwap(Index);
+	bModifiersDirty = true;
+	UpdateReplicatedMax(Attribute);
+
+	SetValue(Attribute, GetValue(Attribute));
+	MarkDirty(Attribute);
+	UpdateRegenActivation();
+}
+
+void UAttributeComponent::EvaluateModifiers() const
+{
+	float AddMax[NumAttributes] = {};
+	float AddRegen[NumAttributes] = {};
+	float ScaleMax[NumAttributes];
+	float ScaleRegen[NumAttributes];
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		ScaleMax[Index] = 1.f;
+		ScaleRegen[Index] = 1.f;
+	}
+
+	for (const FAttributeModifier& Modifier : Modifiers)
+	{
+		const int32 Index = static_cast<int32>(Modifier.Attribute);
+		const bool bMax = Modifier.Target == EAttributeModifierTarget::EAMT_Max;
+		if (Modifier.Op == EAttributeModifierOp::EAMO_Add)
+		{
+			(bMax ? AddMax : AddRegen)[Index] += Modifier.Magnitude;
+		}
+		else
+		{
+			(bMax ? ScaleMax : ScaleRegen)[Index] *= Modifier.Magnitude;
+		}
+	}
+
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		EffectiveMax[Index] = FMath::Max((Definitions[Index].Max + AddMax[Index]) * ScaleMax[Index], Definitions[Index].Min);
+		EffectiveRegen[Index] = (Definitions[Index].RegenRate + AddRegen[Index]) * ScaleRegen[Index];
+	}
+	bModifiersDirty = false;
+}
+
+bool UAttributeComponent::ApplyRegen(float DeltaTime)
+{
+	// Dropped from the active list, nothing regenerates a corpse back to life
+	if (IsOwnerDead()) return false;
+
+	bool bStillRegenerating = false;
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		const EAttributeId Id = static_cast<EAttributeId>(Index);
+		if (!NeedsRegen(Id)) continue;
+
+		const float NewValue = FMath::Clamp(Values[Index] + GetRegenRate(Id) * DeltaTime, Definitions[Index].Min, GetMax(Id));
+		if (NewValue != Values[Index])
+		{
+			Values[Index] = NewValue;
+			RegenChangedAttributes |= 1u << static_cast<uint32>(Index);
+		}
+		bStillRegenerating |= NeedsRegen(Id);
+	}
+	return bStillRegenerating;
+}
+
+void UAttributeComponent::FlushRegenChanges()
+{
+	for (int32 Index = 0; RegenChangedAttributes != 0; ++Index, RegenChangedAttributes >>= 1)
+	{
+		if (RegenChangedAttributes & 1u)
+		{
+			MarkValueDirty(Index);
+		}
+	}
+}
+
+bool UAttributeComponent::NeedsRegen(EAttributeId Id) const
+{
+	const float RegenRate = GetRegenRate(Id);
+	const int32 Index = static_cast<int32>(Id);
+	return (RegenRate > 0.f && Values[Index] < GetMax(Id)) || (RegenRate < 0.f && Values[Index] > Definitions[Index].Min);
+}
+
+bool UAttributeComponent::NeedsRegen() const
+{
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		if (NeedsRegen(static_cast<EAttributeId>(Index))) return true;
+	}
+	return false;
+}
+
+void UAttributeComponent::UpdateRegenActivation()
+{
+	if (RegenSubsystem == nullptr) return;
+
+	if (!IsOwnerDead() && NeedsRegen())
+	{
+		RegenSubsystem->Activate(this);
+	}
+	else
+	{
+		RegenSubsystem->Deactivate(this);
+	}
+}
+
+bool UAttributeComponent::IsOwnerDead() const
+{
+	// Health at its min counts as dead too, the owner may only flag its death once the death montage starts
+	const int32 HealthIndex = static_cast<int32>(EAttributeId::EAI_Health);
+	return Values[HealthIndex] <= Definitions[HealthIndex].Min || (Faction && Faction->HasState(EFactionStateFlags::Dead));
+}
+
+void UAttributeComponent::OnRep_Values()
+{
+	// The changed elements aren't passed in, BroadcastChanges skips the ones that didn't move
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		MarkDirty(static_cast<EAttributeId>(Index));
+	}
+}
+
+void UAttributeComponent::OnRep_Maxes()
+{
+	// Percents move with the max too
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		MarkDirty(static_cast<EAttributeId>(Index));
+	}
 }
 
 void UAttributeComponent::ReceiveDamage(float Damage)
 {
-	Health = FMath::Clamp(Health - Damage, 0.f, MaxHealth);
+	SetValue(EAttributeId::EAI_Health, GetHealth() - Damage);
 }
 
 void UAttributeComponent::UseStamina(float StaminaCost)
 {
-	Stamina = FMath::Clamp(Stamina - StaminaCost, 0.f, MaxStamina);
+	SetValue(EAttributeId::EAI_Stamina, GetStamina() - StaminaCost);
 }
 
-float UAttributeComponent::GetHealthPercent()
+float UAttributeComponent::GetHealthPercent() const
 {
-	return Health / MaxHealth;
+	return GetPercent(EAttributeId::EAI_Health);
 }
 
-float UAttributeComponent::GetStaminaPercent()
+float UAttributeComponent::GetStaminaPercent() const
 {
-	return Stamina / MaxStamina;
+	return GetPercent(EAttributeId::EAI_Stamina);
 }
 
-bool UAttributeComponent::IsAlive()
+bool UAttributeComponent::IsAlive() const
 {
-	return Health > 0.f;
+	return GetHealth() > 0.f;
 }
 
 void UAttributeComponent::AddSouls(int32 NumberOfSouls)
 {
-	Souls += NumberOfSouls;
+	SetValue(EAttributeId::EAI_Souls, GetValue(EAttributeId::EAI_Souls) + NumberOfSouls);
 }
 
-void UAttributeComponent::AddHealth(int32 HealthAmount)
+void UAttributeComponent::AddHealth(float HealthAmount)
 {
-	Health = FMath::Clamp(Health + HealthAmount, 0.f, MaxHealth);
+	SetValue(EAttributeId::EAI_Health, GetHealth() + HealthAmount);
 }
 
 void UAttributeComponent::AddGold(int32 AmountOfGold)
 {
-	Gold += AmountOfGold;
+	SetValue(EAttributeId::EAI_Gold, GetValue(EAttributeId::EAI_Gold) + AmountOfGold);
 }
 
+void UAttributeComponent::ResetAttributes()
+{
+	SetValue(EAttributeId::EAI_Health, GetMax(EAttributeId::EAI_Health));
+	SetValue(EAttributeId::EAI_Stamina, GetMax(EAttributeId::EAI_Stamina));
+}
 
 void UAttributeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	BroadcastChanges();
+	SetComponentTickEnabled(false);
+}
+
+void UAttributeComponent::BroadcastAll()
+{
+	BroadcastHealthPercent = -1.f;
+	BroadcastStaminaPercent = -1.f;
+	BroadcastGold = INDEX_NONE;
+	BroadcastSouls = INDEX_NONE;
+	for (int32 Index = 0; Index < NumAttributes; ++Index)
+	{
+		MarkDirty(static_cast<EAttributeId>(Index));
+	}
+}
+
+void UAttributeComponent::MarkValueDirty(int32 Index)
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME_STATIC_ARRAY_INDEX(UAttributeComponent, Values, Index, this);
+	MarkDirty(static_cast<EAttributeId>(Index));
+}
+
+void UAttributeComponent::UpdateReplicatedMax(EAttributeId Id)
+{
+	const int32 Index = static_cast<int32>(Id);
+	const float Max = GetMax(Id);
+	if (Max == Maxes[Index]) return;
+
+	Maxes[Index] = Max;
+	MARK_PROPERTY_DIRTY_FROM_NAME_STATIC_ARRAY_INDEX(UAttributeComponent, Maxes, Index, this);
+}
+
+void UAttributeComponent::MarkDirty(EAttributeId Id)
+{
+	DirtyAttributes |= 1u << static_cast<uint32>(Id);
+
+	if (!IsComponentTickEnabled() && HasListeners())
+	{
+		SetComponentTickEnabled(true);
+	}
 }
 
-void UAttributeComponent::RegenStamina(float DeltaTime)
+bool UAttributeComponent::HasListeners() const
 {
-	Stamina = FMath::Clamp(Stamina + StaminaRegenRate * DeltaTime, 0.f, MaxStamina);
+	return OnHealthChanged.IsBound() || OnStaminaChanged.IsBound() || OnGoldChanged.IsBound() || OnSoulsChanged.IsBound();
 }
 
+void UAttributeComponent::BroadcastChanges()
+{
+	const uint32 Dirty = DirtyAttributes;
+	DirtyAttributes = 0;
+
+	auto IsDirty = [Dirty](EAttributeId Id) { return (Dirty & (1u << static_cast<uint32>(Id))) != 0; };
+
+	if (IsDirty(EAttributeId::EAI_Health) && OnHealthChanged.IsBound())
+	{
+		const float Percent = GetHealthPercent();
+		if (PercentChanged(Percent, BroadcastHealthPercent, BroadcastTolerance))
+		{
+			BroadcastHealthPercent = Percent;
+			OnHealthChanged.Broadcast(Percent);
+		}
+	}
+
+	if (IsDirty(EAttributeId::EAI_Stamina) && OnStaminaChanged.IsBound())
+	{
+		const float Percent = GetStaminaPercent();
+		if (PercentChanged(Percent, BroadcastStaminaPercent, BroadcastTolerance))
+		{
+			BroadcastStaminaPercent = Percent;
+			OnStaminaChanged.Broadcast(Percent);
+		}
+	}
+
+	if (IsDirty(EAttributeId::EAI_Gold) && GetGold() != BroadcastGold)
+	{
+		BroadcastGold = GetGold();
+		OnGoldChanged.Broadcast(BroadcastGold);
+	}
+
+	if (IsDirty(EAttributeId::EAI_Souls) && GetSouls() != BroadcastSouls)
+	{
+		BroadcastSouls = GetSouls();
+		OnSoulsChanged.Broadcast(BroadcastSouls);
+	}
+}
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AttributeRegenSubsystem.h"
+#include "Components/AttributeComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<float> CVarAttributeRegenHz(
+	TEXT("Slash.Attributes.RegenHz"),
+	10.f,
+	TEXT("Rate at which attribute regen is applied. <= 0 applies it every frame."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAttributeRegenParallelThreshold(
+	TEXT("Slash.Attributes.RegenParallelThreshold"),
+	256,
+	TEXT("Number of regenerating components from which regen is spread over worker threads. <= 0 never does."),
+	ECVF_Default);
+
+void UAttributeRegenSubsystem::Tick(float DeltaTime)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashAttributeRegen);
+	SET_DWORD_STAT(STAT_SlashRegeneratingAttributes, ActiveComponents.Num());
+	if (ActiveComponents.Num() == 0)
+	{
+		StepAccumulator = 0.f;
+		return;
+	}
+
+	const float RegenHz = CVarAttributeRegenHz.GetValueOnGameThread();
+	if (RegenHz <= 0.f)
+	{
+		RunStep(DeltaTime);
+		return;
+	}
+
+	// A hitch is caught up in one step rather than several
+	const float StepTime = 1.f / RegenHz;
+	StepAccumulator += DeltaTime;
+	if (StepAccumulator >= StepTime)
+	{
+		const float Steps = FMath::FloorToFloat(StepAccumulator / StepTime);
+		StepAccumulator -= Steps * StepTime;
+		RunStep(Steps * StepTime);
+	}
+}
+
+TStatId UAttributeRegenSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAttributeRegenSubsystem, STATGROUP_Tickables);
+}
+
+void UAttributeRegenSubsystem::Activate(UAttributeComponent* Attributes)
+{
+	if (Attributes == nullptr || Attributes->RegenIndex != INDEX_NONE) return;
+
+	Attributes->RegenIndex = ActiveComponents.Add(Attributes);
+}
+
+void UAttributeRegenSubsystem::Deactivate(UAttributeComponent* Attributes)
+{
+	const int32 Index = Attributes ? Attributes->RegenIndex : INDEX_NONE;
+	if (!ActiveComponents.IsValidIndex(Index) || ActiveComponents[Index] != Attributes) return;
+
+	ActiveComponents.RemoveAtSwap(Index, 1, false);
+	if (ActiveComponents.IsValidIndex(Index))
+	{
+		ActiveComponents[Index]->RegenIndex = Index;
+	}
+	Attributes->RegenIndex = INDEX_NONE;
+}
+
+bool UAttributeRegenSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAttributeRegenSubsystem::RunStep(float StepTime)
+{
+	const int32 NumActive = ActiveComponents.Num();
+	StillRegenerating.SetNumUninitialized(NumActive, false);
+
+	// Each component only touches its own values here, events are raised below on the game thread
+	const int32 ParallelThreshold = CVarAttributeRegenParallelThreshold.GetValueOnGameThread();
+	ParallelFor(NumActive, [this, StepTime](int32 Index)
+	{
+		StillRegenerating[Index] = ActiveComponents[Index]->ApplyRegen(StepTime);
+	}, ParallelThreshold <= 0 || NumActive < ParallelThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	for (int32 Index = NumActive - 1; Index >= 0; --Index)
+	{
+		UAttributeComponent* Attributes = ActiveComponents[Index];
+		Attributes->FlushRegenChanges();
+		if (!StillRegenerating[Index])
+		{
+			Deactivate(Attributes);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/FactionComponent.h"
+#include "Characters/BaseCharacter.h"
+
+namespace
+{
+	constexpr int32 NumFactions = static_cast<int32>(EFaction::EF_MAX);
+
+	// [A][B], friendly factions can't damage each other
+	constexpr bool FriendlyFactions[NumFactions][NumFactions] =
+	{
+		/*              Neutral Player Enemy */
+		/* Neutral */ { false,  false, false },
+		/* Player  */ { false,  true,  false },
+		/* Enemy   */ { false,  false, true  },
+	};
+}
+
+UFactionComponent::UFactionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+UFactionComponent* UFactionComponent::Find(const AActor* Actor)
+{
+	const ABaseCharacter* Character = Cast<ABaseCharacter>(Actor);
+	return Character ? Character->GetFaction() : nullptr;
+}
+
+bool UFactionComponent::AreFriendly(EFaction A, EFaction B)
+{
+	return FriendlyFactions[static_cast<int32>(A)][static_cast<int32>(B)];
+}
+
+bool UFactionComponent::AreFriendly(const AActor* A, const AActor* B)
+{
+	const UFactionComponent* FactionA = Find(A);
+	const UFactionComponent* FactionB = Find(B);
+	return FactionA && FactionB && AreFriendly(FactionA->Faction, FactionB->Faction);
+}
+
+bool UFactionComponent::IsDead(const AActor* Actor)
+{
+	const UFactionComponent* Component = Find(Actor);
+	return Component && Component->HasState(EFactionStateFlags::Dead);
+}
+
+bool UFactionComponent::IsEngageable(const AActor* Actor)
+{
+	const UFactionComponent* Component = Find(Actor);
+	return Component && Component->HasState(EFactionStateFlags::Engageable) && !Component->HasState(EFactionStateFlags::Dead);
+}
@@ -5,15 +5,38 @@
 #include "AIController.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/FactionComponent.h"
 #include "HUD/HealthBarComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Perception/PawnSensingComponent.h"
 #include "Items/Weapons/Weapon.h"
 #include "Items/Soul.h"
-
-AEnemy::AEnemy()
-{
-	PrimaryActorTick.bCanEverTick = true;
+#include "Items/ItemPoolSubsystem.h"
+#include "Enemy/EnemyAISubsystem.h"
+#include "Enemy/EnemyAISettings.h"
+#include "Enemy/EnemySpawner.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "Combat/CombatEventSubsystem.h"
+#include "Slash/SlashStats.h"
+#include "Spatial/PawnSpatialGridSubsystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Animation/AnimMontage.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
+{
+	PrimaryActorTick.bCanEverTick = false; // Driven by UEnemyAISubsystem
+
+	// Significance is set by UEnemyAISubsystem when the animation budget is enabled (UEnemyAISettings)
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoCalculateSignificance(false);
+	}
+	GetMesh()->bEnableUpdateRateOptimizations = true;
 
 	GetMesh()->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
@@ -27,36 +50,24 @@ AEnemy::AEnemy()
 	bUseControllerRotationPitch = false;
 	bUseControllerRotationRoll = false;
 	bUseControllerRotationYaw = false;
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 
 	PawnSensor = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("PawnSensor"));
 	PawnSensor->SightRadius = 1000.f;
 	PawnSensor->SetPeripheralVisionAngle(45.f);
-}
-
-void AEnemy::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (IsDead()) return;
 
-	if (EnemyState > EEnemyState::EES_Patrolling)
-	{
-		CheckCombatTarget();
-	}
-	else
-	{
-		CheckPatrolTarget();
-	}
+	Faction->SetFaction(EFaction::EF_Enemy);
 }
 
 float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	HandleDamage(DamageAmount);
 	CombatTarget = EventInstigator->GetPawn();
+	UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Damage, CombatTarget, this, DamageAmount, GetActorLocation());
 
 	if (IsInsideAttackRadius()) 
 	{
-		EnemyState = EEnemyState::EES_Attacking;
+		SetEnemyState(EEnemyState::EES_Attacking);
 	} 
 	else if (IsOutsideAttackRadius())
 	{
@@ -68,10 +79,31 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 
 void AEnemy::Destroyed()
 {
-	if (Equipped1hWeapon)
+	if (UWorld* World = GetWorld())
+	{
+		if (UEnemyAISubsystem* EnemyAI = World->GetSubsystem<UEnemyAISubsystem>())
+		{
+			EnemyAI->UnregisterEnemy(this);
+		}
+	}
+
+	// Clients only drop their replica, the server releases the weapon
+	if (Equipped1hWeapon && HasAuthority())
 	{
-		Equipped1hWeapon->Destroy();
+		UItemPoolSubsystem::ReleaseOrDestroy(Equipped1hWeapon);
+		Equipped1hWeapon = nullptr;
 	}
+
+	Super::Destroyed();
+}
+
+void AEnemy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemy, EnemyState, Params);
 }
 
 void AEnemy::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
@@ -89,17 +121,136 @@ void AEnemy::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
 	}
 }
 
+void AEnemy::HandleAIEvent(EEnemyAIEvent Event)
+{
+	if (IsDead()) return;
+
+	switch (Event)
+	{
+	case EEnemyAIEvent::EAE_ReachedPatrolTarget:
+		ReachedPatrolTarget();
+		break;
+	case EEnemyAIEvent::EAE_LostCombatTarget:
+		LostCombatTarget();
+		break;
+	case EEnemyAIEvent::EAE_CombatTargetOutOfReach:
+		CombatTargetOutOfReach();
+		break;
+	case EEnemyAIEvent::EAE_CombatTargetInReach:
+		StartAttackTimer();
+		break;
+	}
+}
+
+void AEnemy::ParkForRespawn()
+{
+	ClearPatrolTimer();
+	ClearAttackTimer();
+	GetWorldTimerManager().ClearTimer(DeathTimer);
+	GetWorldTimerManager().ClearTimer(FreezeAnimationTimer);
+
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+	}
+
+	if (UEnemyAISubsystem* EnemyAI = GetWorld()->GetSubsystem<UEnemyAISubsystem>())
+	{
+		EnemyAI->UnregisterEnemy(this);
+	}
+
+	if (UPawnSpatialGridSubsystem* PawnGrid = GetWorld()->GetSubsystem<UPawnSpatialGridSubsystem>())
+	{
+		PawnGrid->UnregisterPawn(this);
+	}
+
+	CombatTarget = nullptr;
+	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetParked(true);
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	SetAnimationTickEnabled(false);
+	MulticastSetParked(true);
+}
+
+void AEnemy::Respawn(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetParked(false);
+	RestoreAfterDeath();
+	DeathPose = EDeathPose::EDP_MAX;
+
+	if (Attributes)
+	{
+		Attributes->ResetAttributes();
+	}
+
+	StartPatrolling();
+	MulticastSetParked(false);
+
+	// Re-registering resets the LOD tier, which restores movement and mesh ticking
+	if (UPawnSpatialGridSubsystem* PawnGrid = GetWorld()->GetSubsystem<UPawnSpatialGridSubsystem>())
+	{
+		PawnGrid->RegisterPawn(this);
+	}
+
+	if (UEnemyAISubsystem* EnemyAI = GetWorld()->GetSubsystem<UEnemyAISubsystem>())
+	{
+		EnemyAI->RegisterEnemy(this);
+	}
+}
+
+void AEnemy::SetParked(bool bParked)
+{
+	if (bParked)
+	{
+		HideHealthBar();
+	}
+
+	SetActorHiddenInGame(bParked);
+	SetActorEnableCollision(!bParked);
+
+	if (Equipped1hWeapon)
+	{
+		Equipped1hWeapon->SetActorHiddenInGame(bParked);
+	}
+}
+
+void AEnemy::MulticastSetParked_Implementation(bool bParked)
+{
+	// The server parks and respawns in ParkForRespawn and Respawn, its LOD tiers restore the ticks
+	if (HasAuthority()) return;
+
+	SetParked(bParked);
+	GetCharacterMovement()->SetComponentTickEnabled(!bParked);
+	SetAnimationTickEnabled(!bParked);
+}
+
+void AEnemy::SetPatrolTargets(const TArray<AActor*>& NewPatrolTargets)
+{
+	PatrolTargets = NewPatrolTargets;
+	PatrolTarget = ChoosePatrolTarget();
+}
+
 void AEnemy::BeginPlay()
 {
 	Super::BeginPlay();
 
 	if (PawnSensor)
 	{
-		PawnSensor->OnSeePawn.AddDynamic(this, &AEnemy::PawnSeen);
+		PawnSensor->SetSensingUpdatesEnabled(false);
 	}
 
 	InitializeEnemy();
-	Tags.Add(FName("Enemy"));
+
+	if (!HasAuthority() && Attributes)
+	{
+		Attributes->OnHealthChanged.AddUObject(this, &AEnemy::OnHealthChanged);
+	}
+
+	if (UEnemyAISubsystem* EnemyAI = GetWorld()->GetSubsystem<UEnemyAISubsystem>())
+	{
+		EnemyAI->RegisterEnemy(this);
+	}
 }
 
 bool AEnemy::CanAttack()
@@ -119,7 +270,7 @@ void AEnemy::Attack()
 
 	if (CombatTarget == nullptr) return;
 
-	EnemyState = EEnemyState::EES_Engaged;
+	SetEnemyState(EEnemyState::EES_Engaged);
 
 	if (Equipped1hWeapon)
 	{
@@ -129,7 +280,10 @@ void AEnemy::Attack()
 
 void AEnemy::AttackEnd()
 {
-	EnemyState = EEnemyState::EES_NoState;
+	// Called by anim notifies on every machine, the AI state is only changed by the server
+	if (!HasAuthority()) return;
+
+	SetEnemyState(EEnemyState::EES_NoState);
 	CheckCombatTarget();
 }
 
@@ -147,36 +301,138 @@ void AEnemy::Die_Implementation()
 {
 	Super::Die_Implementation();
 
-	EnemyState = EEnemyState::EES_Dead;
+	SetEnemyState(EEnemyState::EES_Dead);
 
 	ClearAttackTimer();
 	HideHealthBar();
 	DisableCapsule();
 	DisableMeshCollision();
-	SetLifeSpan(DeathLifeSpan);
+	if (Spawner)
+	{
+		GetWorldTimerManager().SetTimer(DeathTimer, this, &AEnemy::DeathTimerFinished, DeathLifeSpan);
+	}
+	else
+	{
+		SetLifeSpan(DeathLifeSpan);
+	}
 	GetCharacterMovement()->bOrientRotationToMovement = false;
 	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
 	SpawnSoul();
+	ScheduleFreezeAnimation();
+}
+
+void AEnemy::OnRep_DeathPose()
+{
+	Super::OnRep_DeathPose();
+
+	if (DeathPose < EDeathPose::EDP_MAX)
+	{
+		ScheduleFreezeAnimation();
+	}
+}
+
+void AEnemy::OnRep_EnemyState(EEnemyState OldState)
+{
+	// Mirrors what the server did around the state change, the death montage comes with DeathPose
+	if (EnemyState == EEnemyState::EES_Dead)
+	{
+		HideHealthBar();
+		DisableCapsule();
+		DisableMeshCollision();
+	}
+	else if (OldState == EEnemyState::EES_Dead)
+	{
+		RestoreAfterDeath();
+	}
+	else if (EnemyState == EEnemyState::EES_Patrolling)
+	{
+		HideHealthBar();
+	}
+}
+
+void AEnemy::OnHealthChanged(float Percent)
+{
+	if (HealthBarWidget)
+	{
+		HealthBarWidget->SetHealthPercent(Percent);
+	}
+
+	if (Percent < 1.f && !IsDead())
+	{
+		ShowHealthBar();
+	}
+}
+
+void AEnemy::ScheduleFreezeAnimation()
+{
+	// The death pose doesn't change once the montage is over, stop evaluating bones until respawn or destruction
+	const UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+	const UAnimMontage* ActiveMontage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+	const float RemainingTime = ActiveMontage ? (ActiveMontage->GetPlayLength() - AnimInstance->Montage_GetPosition(ActiveMontage)) / FMath::Max(ActiveMontage->RateScale, UE_KINDA_SMALL_NUMBER) : 0.f;
+	if (RemainingTime > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(FreezeAnimationTimer, this, &AEnemy::FreezeAnimation, RemainingTime);
+	}
+	else
+	{
+		FreezeAnimation();
+	}
+}
+
+void AEnemy::FreezeAnimation()
+{
+	if (IsDead())
+	{
+		SetAnimationTickEnabled(false);
+	}
+}
+
+void AEnemy::RestoreAfterDeath()
+{
+	GetWorldTimerManager().ClearTimer(FreezeAnimationTimer);
+	EnableCapsule();
+	EnableMeshCollision();
+	GetCharacterMovement()->bOrientRotationToMovement = true;
+	Faction->RemoveState(EFactionStateFlags::Dead);
+
+	SetAnimationTickEnabled(true);
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
+
+	if (HealthBarWidget)
+	{
+		HealthBarWidget->SetHealthPercent(1.f);
+	}
 }
 
 void AEnemy::SpawnSoul()
 {
-	UWorld* World = GetWorld();
-	if (World && SoulClass && Attributes)
+	UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>();
+	if (ItemPool && SoulClass && Attributes)
 	{
 		const FVector SpawnLocation = GetActorLocation() + FVector(0.f, 0.f, 125.f);
-		ASoul* SpawnedSoul = World->SpawnActor<ASoul>(SoulClass, SpawnLocation, GetActorRotation());
+		ASoul* SpawnedSoul = ItemPool->Acquire<ASoul>(SoulClass, SpawnLocation, GetActorRotation(), this);
 		if (SpawnedSoul) 
 		{
+			INC_DWORD_STAT(STAT_SlashPickupsSpawned);
 			SpawnedSoul->SetSouls(Attributes->GetSouls());
-			SpawnedSoul->SetOwner(this);
 		}
 	}
 }
 
 void AEnemy::HitReactEnd()
 {
-	EnemyState = EEnemyState::EES_HitReaction;
+	if (!HasAuthority()) return;
+
+	SetEnemyState(EEnemyState::EES_HitReaction);
+}
+
+void AEnemy::SetEnemyState(EEnemyState NewState)
+{
+	EnemyState = NewState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AEnemy, EnemyState, this);
 }
 
 void AEnemy::InitializeEnemy()
@@ -184,27 +440,74 @@ void AEnemy::InitializeEnemy()
 	EnemyController = Cast<AAIController>(GetController());
 	MoveToTarget(PatrolTarget);
 	HideHealthBar();
-	SpawnDefaultWeapon();
+
+	// Clients receive the weapon with Equipped1hWeapon
+	if (HasAuthority())
+	{
+		SpawnDefaultWeapon();
+	}
 }
 
 void AEnemy::SpawnDefaultWeapon()
 {
-	UWorld* World = GetWorld();
-	if (World && WeaponClass)
+	UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>();
+	if (ItemPool && WeaponClass)
+	{
+		AWeapon* DefaultWeapon = ItemPool->Acquire<AWeapon>(WeaponClass, GetActorLocation(), GetActorRotation(), this);
+		if (DefaultWeapon)
+		{
+			DefaultWeapon->Equip(GetMesh(), FName("WeaponSocket"), this, this);
+			Equipped1hWeapon = DefaultWeapon;
+		}
+	}
+}
+
+void AEnemy::SetLODTier(EEnemyLODTier NewTier)
+{
+	LODTier = NewTier;
+
+	const bool bDormant = LODTier == EEnemyLODTier::ELT_Dormant;
+	const FEnemyLODTierSettings& TierSettings = GetDefault<UEnemyAISettings>()->GetTierSettings(LODTier);
+
+	GetCharacterMovement()->SetComponentTickEnabled(!bDormant);
+	GetCharacterMovement()->SetComponentTickInterval(TierSettings.TickInterval);
+
+	// Under the animation budget the allocator owns the mesh tick rate, only dormancy is applied here
+	SetAnimationTickEnabled(!bDormant);
+	const IAnimationBudgetAllocator* AnimationBudget = IAnimationBudgetAllocator::Get(GetWorld());
+	if (AnimationBudget == nullptr || !AnimationBudget->GetEnabled())
+	{
+		GetMesh()->SetComponentTickInterval(TierSettings.AnimationTickInterval);
+		GetMesh()->VisibilityBasedAnimTickOption = LODTier == EEnemyLODTier::ELT_Engaged ?
+			EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones :
+			EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+
+	if (EnemyController)
 	{
-		AWeapon* DefaultWeapon = World->SpawnActor<AWeapon>(WeaponClass);
-		DefaultWeapon->Equip(GetMesh(), FName("WeaponSocket"), this, this);
-		Equipped1hWeapon = DefaultWeapon;
+		EnemyController->SetActorTickEnabled(!bDormant);
+		EnemyController->SetActorTickInterval(TierSettings.TickInterval);
+
+		if (UPathFollowingComponent* PathFollowing = EnemyController->GetPathFollowingComponent())
+		{
+			PathFollowing->SetComponentTickEnabled(!bDormant);
+			PathFollowing->SetComponentTickInterval(TierSettings.PathingInterval);
+		}
 	}
 }
 
-void AEnemy::CheckPatrolTarget()
+void AEnemy::SetAnimationTickEnabled(bool bEnabled)
 {
-	if (InTargetRange(PatrolTarget, PatrolRadius))
+	IAnimationBudgetAllocator* AnimationBudget = IAnimationBudgetAllocator::Get(GetWorld());
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+	if (AnimationBudget && BudgetedMesh)
+	{
+		// Also falls back to the component's own tick when the allocator is disabled
+		AnimationBudget->SetComponentTickEnabled(BudgetedMesh, bEnabled);
+	}
+	else
 	{
-		PatrolTarget = ChoosePatrolTarget();
-		float WaitTime = FMath::RandRange(PatrolWaitMin, PatrolWaitMax);
-		GetWorldTimerManager().SetTimer(PatrolTimer, this, &AEnemy::PatrolTimerFinished, WaitTime);
+		GetMesh()->SetComponentTickEnabled(bEnabled);
 	}
 }
 
@@ -212,14 +515,11 @@ void AEnemy::CheckCombatTarget()
 {
 	if (IsOutsideCombatRadius())
 	{
-		ClearAttackTimer();
-		LoseInterest();
-		if (!IsEngaged()) StartPatrolling();
+		LostCombatTarget();
 	}
 	else if (IsOutsideAttackRadius() && !IsChasing())
 	{
-		ClearAttackTimer();
-		if (!IsEngaged()) ChaseTarget();
+		CombatTargetOutOfReach();
 	}
 	else if (CanAttack())
 	{
@@ -227,11 +527,43 @@ void AEnemy::CheckCombatTarget()
 	}
 }
 
+void AEnemy::ReachedPatrolTarget()
+{
+	PatrolTarget = ChoosePatrolTarget();
+	const float WaitTime = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_AI).FRandRange(PatrolWaitMin, PatrolWaitMax);
+	GetWorldTimerManager().SetTimer(PatrolTimer, this, &AEnemy::PatrolTimerFinished, WaitTime);
+}
+
+void AEnemy::LostCombatTarget()
+{
+	ClearAttackTimer();
+	LoseInterest();
+	if (!IsEngaged()) StartPatrolling();
+}
+
+void AEnemy::CombatTargetOutOfReach()
+{
+	ClearAttackTimer();
+	if (!IsEngaged()) ChaseTarget();
+}
+
 void AEnemy::PatrolTimerFinished()
 {
 	MoveToTarget(PatrolTarget);
 }
 
+void AEnemy::DeathTimerFinished()
+{
+	if (Spawner)
+	{
+		Spawner->RecycleEnemy(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
 void AEnemy::HideHealthBar()
 {
 	if (HealthBarWidget)
@@ -256,14 +588,14 @@ void AEnemy::LoseInterest()
 
 void AEnemy::StartPatrolling()
 {
-	EnemyState = EEnemyState::EES_Patrolling;
+	SetEnemyState(EEnemyState::EES_Patrolling);
 	GetCharacterMovement()->MaxWalkSpeed = PatrollingSpeed;
 	MoveToTarget(PatrolTarget);
 }
 
 void AEnemy::ChaseTarget()
 {
-	EnemyState = EEnemyState::EES_Chasing;
+	SetEnemyState(EEnemyState::EES_Chasing);
 	GetCharacterMovement()->MaxWalkSpeed = ChasingSpeed;
 	MoveToTarget(CombatTarget);
 }
@@ -275,8 +607,8 @@ void AEnemy::ClearPatrolTimer()
 
 void AEnemy::StartAttackTimer()
 {
-	EnemyState = EEnemyState::EES_Attacking;
-	const float AttackTime = FMath::RandRange(AttackMin, AttackMax);
+	SetEnemyState(EEnemyState::EES_Attacking);
+	const float AttackTime = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_Combat).FRandRange(AttackMin, AttackMax);
 	GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemy::Attack, AttackTime);
 }
 
@@ -324,8 +656,7 @@ bool AEnemy::InTargetRange(AActor* Target, double Radius)
 {
 	if (Target == nullptr) return false;
 
-	const double DistanceToTarget = (Target->GetActorLocation() - GetActorLocation()).Size();
-	return DistanceToTarget <= Radius;
+	return FVector::DistSquared(Target->GetActorLocation(), GetActorLocation()) <= FMath::Square(Radius);
 }
 
 void AEnemy::MoveToTarget(AActor* Target)
@@ -352,21 +683,30 @@ AActor* AEnemy::ChoosePatrolTarget()
 	const int32 NumPatrolTargets = ValidTargets.Num();
 	if (NumPatrolTargets > 0)
 	{
-		const int32 TargetSelection = FMath::RandRange(0, NumPatrolTargets - 1);
+		const int32 TargetSelection = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_AI).RandRange(0, NumPatrolTargets - 1);
 		return ValidTargets[TargetSelection];
 	}
 
 	return nullptr;
 }
 
+bool AEnemy::CanSeePawn(APawn* Pawn)
+{
+	const bool bIsTarget = Pawn != this && UFactionComponent::IsEngageable(Pawn);
+
+	if (!bIsTarget || EnemyController == nullptr) return bIsTarget;
+
+	SLASH_COUNT_TRACE();
+	return EnemyController->LineOfSightTo(Pawn);
+}
+
 void AEnemy::PawnSeen(APawn* SeenPawn)
 {
 	const bool bShouldChaseTarget =
 		EnemyState != EEnemyState::EES_Dead &&
 		EnemyState != EEnemyState::EES_Chasing &&
 		EnemyState < EEnemyState::EES_Attacking &&
-		SeenPawn->ActorHasTag(FName("EngageableTarget")) &&
-		!SeenPawn->ActorHasTag(FName("Dead"));
+		UFactionComponent::IsEngageable(SeenPawn);
 
 	if (bShouldChaseTarget)
 	{
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAISettings.h"
+
+UEnemyAISettings::UEnemyAISettings()
+{
+	CategoryName = TEXT("Game");
+
+	Near.PathingInterval = 0.1f;
+
+	Far.TickInterval = 0.1f;
+	Far.AnimationTickInterval = 0.1f;
+	Far.SensingInterval = 1.5f;
+	Far.PathingInterval = 0.5f;
+}
+
+const FEnemyLODTierSettings& UEnemyAISettings::GetTierSettings(EEnemyLODTier Tier) const
+{
+	switch (Tier)
+	{
+	case EEnemyLODTier::ELT_Engaged:
+		return Engaged;
+	case EEnemyLODTier::ELT_Near:
+		return Near;
+	default:
+		return Far;
+	}
+}
@@ -0,0 +1,364 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAISubsystem.h"
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemyAISettings.h"
+#include "Spatial/PawnSpatialGridSubsystem.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Perception/PawnSensingComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "AnimationBudgetAllocatorParameters.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<float> CVarEnemyAIBudgetMs(
+	TEXT("Slash.AI.BudgetMs"),
+	0.5f,
+	TEXT("Per-frame time budget in milliseconds for enemy AI decisions (patrol, chase, attack).\n")
+	TEXT("Decisions that don't fit are re-evaluated next frame. <= 0 disables the budget."),
+	ECVF_Default);
+
+void UEnemyAISubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UEnemyAISettings* Settings = GetDefault<UEnemyAISettings>();
+	AnimationBudget = IAnimationBudgetAllocator::Get(&InWorld);
+	if (AnimationBudget)
+	{
+		FAnimationBudgetAllocatorParameters Parameters;
+		Parameters.BudgetInMs = Settings->AnimationBudgetMs;
+		Parameters.MaxTickRate = Settings->AnimationBudgetMaxTickRate;
+		AnimationBudget->SetParameters(Parameters);
+		AnimationBudget->SetEnabled(Settings->bUseAnimationBudget);
+	}
+}
+
+void UEnemyAISubsystem::Tick(float DeltaTime)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashEnemyAI);
+	if (Enemies.Num() == 0) return;
+
+	GatherEnemyData();
+	UpdateLODTiers();
+	UpdateAnimationSignificance();
+
+	// Enemies replicate their state from the server's decisions
+	if (GetWorld()->GetNetMode() == NM_Client) return;
+
+	UpdateSight(DeltaTime);
+	EvaluateTransitions();
+	DispatchEvents();
+}
+
+TStatId UEnemyAISubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAISubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyAISubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemies.Contains(Enemy)) return;
+
+	Enemies.Add(Enemy);
+	Locations.Add(Enemy->GetActorLocation());
+	TargetLocations.Add(FVector::ZeroVector);
+	HasTarget.Add(false);
+	States.Add(Enemy->EnemyState);
+	PatrolRadiiSquared.Add(FMath::Square(Enemy->PatrolRadius));
+	CombatRadiiSquared.Add(FMath::Square(Enemy->CombatRadius));
+	AttackRadiiSquared.Add(FMath::Square(Enemy->AttackRadius));
+	Rendered.Add(true);
+	LODTiers.Add(EEnemyLODTier::ELT_MAX); // Applied on the first pass
+	SightRadii.Add(Enemy->PawnSensor ? Enemy->PawnSensor->SightRadius : 0.0);
+	SightHalfAngles.Add(Enemy->PawnSensor ? Enemy->PawnSensor->GetPeripheralVisionAngle() : 0.f);
+	SightTimers.Add(URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_AI).FRand() * GetDefault<UEnemyAISettings>()->Near.SensingInterval); // Stagger the first checks
+}
+
+void UEnemyAISubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	const int32 Index = Enemies.Find(Enemy);
+	if (Index == INDEX_NONE) return;
+
+	Enemies.RemoveAtSwap(Index);
+	Locations.RemoveAtSwap(Index);
+	TargetLocations.RemoveAtSwap(Index);
+	HasTarget.RemoveAtSwap(Index);
+	States.RemoveAtSwap(Index);
+	PatrolRadiiSquared.RemoveAtSwap(Index);
+	CombatRadiiSquared.RemoveAtSwap(Index);
+	AttackRadiiSquared.RemoveAtSwap(Index);
+	Rendered.RemoveAtSwap(Index);
+	LODTiers.RemoveAtSwap(Index);
+	SightRadii.RemoveAtSwap(Index);
+	SightHalfAngles.RemoveAtSwap(Index);
+	SightTimers.RemoveAtSwap(Index);
+}
+
+bool UEnemyAISubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAISubsystem::GatherEnemyData()
+{
+	const UEnemyAISettings* Settings = GetDefault<UEnemyAISettings>();
+
+	// A server can't tell whether a remote player sees an enemy, and nothing is ever rendered under -nullrhi
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	const bool bDemoteWhenNotRendered = Settings->bDemoteWhenNotRendered && FApp::CanEverRender() &&
+		(NetMode == NM_Standalone || NetMode == NM_Client);
+
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		const AEnemy* Enemy = Enemies[Index];
+		if (!IsValid(Enemy))
+		{
+			States[Index] = EEnemyState::EES_Dead;
+			continue;
+		}
+
+		States[Index] = Enemy->EnemyState;
+		Locations[Index] = Enemy->GetActorLocation();
+		Rendered[Index] = !bDemoteWhenNotRendered || Enemy->GetMesh()->WasRecentlyRendered(Settings->RenderedGraceTime);
+
+		const AActor* Target = States[Index] > EEnemyState::EES_Patrolling ? Enemy->CombatTarget : Enemy->PatrolTarget;
+		HasTarget[Index] = Target != nullptr;
+		if (Target)
+		{
+			TargetLocations[Index] = Target->GetActorLocation();
+		}
+	}
+}
+
+void UEnemyAISubsystem::UpdateLODTiers()
+{
+	// Every player on a server, only the local one on a client
+	PlayerLocations.Reset();
+	PlayerPawns.Reset();
+	PlayerTargets.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (PlayerPawn)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+			PlayerPawns.Add(PlayerPawn);
+
+			const ABaseCharacter* PlayerCharacter = Cast<ABaseCharacter>(PlayerPawn);
+			PlayerTargets.Add(PlayerCharacter ? PlayerCharacter->GetCombatTarget() : nullptr);
+		}
+	}
+
+	FMemory::Memzero(TierCounts);
+	uint32 NumLiveEnemies = 0;
+
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		if (!IsValid(Enemies[Index])) continue;
+
+		if (States[Index] != EEnemyState::EES_Dead)
+		{
+			++NumLiveEnemies;
+		}
+
+		EEnemyLODTier Tier = EEnemyLODTier::ELT_Near;
+		if (PlayerLocations.Num() > 0)
+		{
+			double DistanceSquared = TNumericLimits<double>::Max();
+			for (const FVector& PlayerLocation : PlayerLocations)
+			{
+				DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Locations[Index], PlayerLocation));
+			}
+			Tier = ComputeLODTier(Index, DistanceSquared);
+		}
+		if (Tier != LODTiers[Index])
+		{
+			LODTiers[Index] = Tier;
+			Enemies[Index]->SetLODTier(Tier);
+		}
+		++TierCounts[static_cast<int32>(Tier)];
+	}
+
+	SET_DWORD_STAT(STAT_SlashLiveEnemies, NumLiveEnemies);
+	SET_DWORD_STAT(STAT_SlashEnemiesEngaged, TierCounts[static_cast<int32>(EEnemyLODTier::ELT_Engaged)]);
+	SET_DWORD_STAT(STAT_SlashEnemiesNear, TierCounts[static_cast<int32>(EEnemyLODTier::ELT_Near)]);
+	SET_DWORD_STAT(STAT_SlashEnemiesFar, TierCounts[static_cast<int32>(EEnemyLODTier::ELT_Far)]);
+	SET_DWORD_STAT(STAT_SlashEnemiesDormant, TierCounts[static_cast<int32>(EEnemyLODTier::ELT_Dormant)]);
+}
+
+EEnemyLODTier UEnemyAISubsystem::ComputeLODTier(int32 Index, double PlayerDistanceSquared) const
+{
+	// Dead enemies keep their tier so the death montage isn't cut short
+	if (States[Index] == EEnemyState::EES_Dead && LODTiers[Index] != EEnemyLODTier::ELT_MAX) return LODTiers[Index];
+	if (States[Index] > EEnemyState::EES_Patrolling) return EEnemyLODTier::ELT_Engaged;
+
+	const UEnemyAISettings* Settings = GetDefault<UEnemyAISettings>();
+	const EEnemyLODTier CurrentTier = LODTiers[Index];
+
+	// Only apply hysteresis when the enemy is moving away from a closer tier
+	const double NearDistance = Settings->NearDistance + (CurrentTier <= EEnemyLODTier::ELT_Near ? Settings->TierHysteresis : 0.0);
+	const double FarDistance = Settings->FarDistance + (CurrentTier <= EEnemyLODTier::ELT_Far ? Settings->TierHysteresis : 0.0);
+
+	EEnemyLODTier Tier = EEnemyLODTier::ELT_Dormant;
+	if (PlayerDistanceSquared <= FMath::Square(NearDistance))
+	{
+		Tier = EEnemyLODTier::ELT_Near;
+	}
+	else if (PlayerDistanceSquared <= FMath::Square(FarDistance))
+	{
+		Tier = EEnemyLODTier::ELT_Far;
+	}
+
+	if (!Rendered[Index] && Tier < EEnemyLODTier::ELT_Dormant)
+	{
+		Tier = static_cast<EEnemyLODTier>(static_cast<uint8>(Tier) + 1);
+	}
+
+	return Tier;
+}
+
+void UEnemyAISubsystem::UpdateAnimationSignificance()
+{
+	if (AnimationBudget == nullptr || !AnimationBudget->GetEnabled()) return;
+
+	// Players were gathered by UpdateLODTiers this frame
+	const double InvFarDistance = 1.0 / FMath::Max(GetDefault<UEnemyAISettings>()->FarDistance, 1.0);
+
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		// Dead enemies stop ticking once their death montage is over (AEnemy::FreezeAnimation)
+		if (!IsValid(Enemies[Index]) || States[Index] == EEnemyState::EES_Dead) continue;
+
+		USkeletalMeshComponentBudgeted* Mesh = Cast<USkeletalMeshComponentBudgeted>(Enemies[Index]->GetMesh());
+		if (Mesh == nullptr) continue;
+
+		// Any player's target and enemies fighting any player are never skipped, their weapon sweeps read the pose
+		const AActor* EnemyTarget = Enemies[Index]->GetCombatTarget();
+		const bool bPlayerTarget = PlayerTargets.Contains(Enemies[Index]) || (EnemyTarget && PlayerPawns.Contains(EnemyTarget));
+		const bool bEngaged = LODTiers[Index] == EEnemyLODTier::ELT_Engaged;
+
+		double DistanceSquared = PlayerLocations.Num() > 0 ? TNumericLimits<double>::Max() : FMath::Square(GetDefault<UEnemyAISettings>()->FarDistance);
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Locations[Index], PlayerLocation));
+		}
+		const float Distance = static_cast<float>(FMath::Min(FMath::Sqrt(DistanceSquared) * InvFarDistance, 1.0));
+		const float Significance = bPlayerTarget ? 1.f : 0.9f - 0.8f * Distance;
+
+		AnimationBudget->SetComponentSignificance(Mesh, Significance, bPlayerTarget, bEngaged, !bPlayerTarget);
+	}
+}
+
+void UEnemyAISubsystem::UpdateSight(float DeltaTime)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashEnemySight);
+	const UPawnSpatialGridSubsystem* PawnGrid = GetWorld()->GetSubsystem<UPawnSpatialGridSubsystem>();
+	if (PawnGrid == nullptr) return;
+
+	const UEnemyAISettings* Settings = GetDefault<UEnemyAISettings>();
+
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		// Same gate as AEnemy::PawnSeen, busy enemies don't need to look around
+		const EEnemyState State = States[Index];
+		if (State == EEnemyState::EES_Dead ||
+			State == EEnemyState::EES_Chasing ||
+			State >= EEnemyState::EES_Attacking ||
+			LODTiers[Index] == EEnemyLODTier::ELT_Dormant)
+		{
+			continue;
+		}
+
+		SightTimers[Index] -= DeltaTime;
+		if (SightTimers[Index] > 0.f) continue;
+		SightTimers[Index] = Settings->GetTierSettings(LODTiers[Index]).SensingInterval;
+
+		AEnemy* Enemy = Enemies[Index];
+		SeenPawns.Reset();
+		PawnGrid->QueryPawnsInCone(Locations[Index], Enemy->GetActorForwardVector(), SightRadii[Index], SightHalfAngles[Index], SeenPawns);
+
+		for (APawn* Pawn : SeenPawns)
+		{
+			if (Enemy->CanSeePawn(Pawn))
+			{
+				Enemy->PawnSeen(Pawn);
+
+				// Keep this frame's transition pass in sync with the new target
+				States[Index] = Enemy->EnemyState;
+				HasTarget[Index] = true;
+				TargetLocations[Index] = Pawn->GetActorLocation();
+				break;
+			}
+		}
+	}
+}
+
+void UEnemyAISubsystem::EvaluateTransitions()
+{
+	PendingEvents.Reset();
+
+	for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+	{
+		const EEnemyState State = States[Index];
+		if (State == EEnemyState::EES_Dead || LODTiers[Index] == EEnemyLODTier::ELT_Dormant) continue;
+
+		const double DistanceSquared = HasTarget[Index] ? FVector::DistSquared(Locations[Index], TargetLocations[Index]) : TNumericLimits<double>::Max();
+
+		if (State > EEnemyState::EES_Patrolling)
+		{
+			const bool bInsideCombatRadius = DistanceSquared <= CombatRadiiSquared[Index];
+			const bool bInsideAttackRadius = DistanceSquared <= AttackRadiiSquared[Index];
+
+			if (!bInsideCombatRadius)
+			{
+				PendingEvents.Add({ Enemies[Index], EEnemyAIEvent::EAE_LostCombatTarget });
+			}
+			else if (!bInsideAttackRadius && State != EEnemyState::EES_Chasing)
+			{
+				PendingEvents.Add({ Enemies[Index], EEnemyAIEvent::EAE_CombatTargetOutOfReach });
+			}
+			else if (bInsideAttackRadius && State != EEnemyState::EES_Attacking && State != EEnemyState::EES_Engaged)
+			{
+				PendingEvents.Add({ Enemies[Index], EEnemyAIEvent::EAE_CombatTargetInReach });
+			}
+		}
+		else if (DistanceSquared <= PatrolRadiiSquared[Index])
+		{
+			PendingEvents.Add({ Enemies[Index], EEnemyAIEvent::EAE_ReachedPatrolTarget });
+		}
+	}
+}
+
+void UEnemyAISubsystem::DispatchEvents()
+{
+	const int32 NumEvents = PendingEvents.Num();
+	if (NumEvents == 0) return;
+
+	const float BudgetMs = CVarEnemyAIBudgetMs.GetValueOnGameThread();
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Start where last frame's budget ran out so no enemy is starved
+	const int32 FirstEvent = DispatchCursor % NumEvents;
+	for (int32 Offset = 0; Offset < NumEvents; ++Offset)
+	{
+		const int32 EventIndex = (FirstEvent + Offset) % NumEvents;
+		if (AEnemy* Enemy = PendingEvents[EventIndex].Enemy.Get())
+		{
+			Enemy->HandleAIEvent(PendingEvents[EventIndex].Event);
+		}
+
+		if (BudgetMs > 0.f && (FPlatformTime::Seconds() - StartTime) * 1000.0 >= BudgetMs)
+		{
+			DispatchCursor = EventIndex + 1;
+			return;
+		}
+	}
+
+	DispatchCursor = 0;
+}
@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemySpawner.h"
+#include "Enemy/Enemy.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "Random/RandomStreamSubsystem.h"
+
+AEnemySpawner::AEnemySpawner()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("SpawnerRoot")));
+}
+
+void AEnemySpawner::RecycleEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || ParkedEnemies.Contains(Enemy)) return;
+
+	ActiveEnemies.RemoveSwap(Enemy);
+	Enemy->ParkForRespawn();
+	ParkedEnemies.Add(Enemy);
+}
+
+void AEnemySpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The spawner isn't replicated, so clients have authority over their own copy and must be told apart by net mode
+	if (GetNetMode() == NM_Client || EnemyClasses.Num() == 0) return;
+
+	for (int32 Index = 0; Index < PrewarmCount; ++Index)
+	{
+		TSubclassOf<AEnemy> EnemyClass = EnemyClasses[Index % EnemyClasses.Num()];
+		if (AEnemy* Enemy = SpawnEnemy(EnemyClass, GetActorTransform()))
+		{
+			Enemy->ParkForRespawn();
+			ParkedEnemies.Add(Enemy);
+		}
+	}
+
+	GetWorldTimerManager().SetTimer(WaveTimer, this, &AEnemySpawner::SpawnWave, WaveInterval, true, FirstWaveDelay);
+}
+
+void AEnemySpawner::SpawnWave()
+{
+	TArray<FVector, TInlineAllocator<8>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+	if (PlayerLocations.Num() == 0) return;
+
+	ActiveEnemies.RemoveAllSwap([](const AEnemy* Enemy) { return !IsValid(Enemy); });
+	ParkedEnemies.RemoveAllSwap([](const AEnemy* Enemy) { return !IsValid(Enemy); });
+	RecycleDistantEnemies(PlayerLocations);
+
+	FRandomStream& Stream = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_AI);
+	const int32 NumToSpawn = FMath::Min(WaveSize, MaxActiveEnemies - ActiveEnemies.Num());
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		TSubclassOf<AEnemy> EnemyClass = EnemyClasses[Stream.RandRange(0, EnemyClasses.Num() - 1)];
+
+		// Each wave is spread over the players in turn
+		const int32 PlayerIndex = Index % PlayerLocations.Num();
+		FVector SpawnLocation;
+		if (!FindSpawnLocation(PlayerLocations, PlayerIndex, EnemyClass, SpawnLocation)) continue;
+
+		const FRotator SpawnRotation(0.f, (PlayerLocations[PlayerIndex] - SpawnLocation).Rotation().Yaw, 0.f);
+		if (AEnemy* Enemy = AcquireEnemy(EnemyClass, FTransform(SpawnRotation, SpawnLocation)))
+		{
+			ActiveEnemies.Add(Enemy);
+		}
+	}
+}
+
+void AEnemySpawner::RecycleDistantEnemies(TArrayView<const FVector> PlayerLocations)
+{
+	const double RecycleDistanceSquared = FMath::Square(RecycleDistance);
+	for (int32 Index = ActiveEnemies.Num() - 1; Index >= 0; --Index)
+	{
+		AEnemy* Enemy = ActiveEnemies[Index];
+		if (Enemy->GetEnemyState() != EEnemyState::EES_Patrolling) continue;
+
+		const FVector EnemyLocation = Enemy->GetActorLocation();
+		const bool bNearPlayer = PlayerLocations.ContainsByPredicate([&EnemyLocation, RecycleDistanceSquared](const FVector& PlayerLocation)
+		{
+			return FVector::DistSquared(EnemyLocation, PlayerLocation) <= RecycleDistanceSquared;
+		});
+
+		if (!bNearPlayer)
+		{
+			RecycleEnemy(Enemy);
+		}
+	}
+}
+
+AEnemy* AEnemySpawner::AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	const int32 ParkedIndex = ParkedEnemies.IndexOfByPredicate([EnemyClass](const AEnemy* Enemy)
+	{
+		return Enemy->GetClass() == EnemyClass;
+	});
+
+	if (ParkedIndex == INDEX_NONE)
+	{
+		return SpawnEnemy(EnemyClass, SpawnTransform);
+	}
+
+	AEnemy* Enemy = ParkedEnemies[ParkedIndex];
+	ParkedEnemies.RemoveAtSwap(ParkedIndex);
+	Enemy->Respawn(SpawnTransform);
+	return Enemy;
+}
+
+AEnemy* AEnemySpawner::SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	AEnemy* Enemy = GetWorld()->SpawnActorDeferred<AEnemy>(EnemyClass, SpawnTransform, this, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (Enemy)
+	{
+		Enemy->SetSpawner(this);
+		Enemy->SetPatrolTargets(PatrolTargets);
+		UGameplayStatics::FinishSpawningActor(Enemy, SpawnTransform);
+	}
+	return Enemy;
+}
+
+bool AEnemySpawner::FindSpawnLocation(TArrayView<const FVector> PlayerLocations, int32 PlayerIndex, TSubclassOf<AEnemy> EnemyClass, FVector& OutLocation) const
+{
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSystem == nullptr) return false;
+
+	FRandomStream& Stream = URandomStreamSubsystem::GetStream(this, ERandomStream::ERS_AI);
+	const float HalfHeight = EnemyClass->GetDefaultObject<AEnemy>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const FVector& PlayerLocation = PlayerLocations[PlayerIndex];
+	const double MinSpawnDistanceSquared = FMath::Square(MinSpawnDistance);
+	for (int32 Attempt = 0; Attempt < SpawnLocationAttempts; ++Attempt)
+	{
+		const double Angle = Stream.FRandRange(0.0, UE_TWO_PI);
+		const double Distance = Stream.FRandRange(MinSpawnDistance, MaxSpawnDistance);
+		const FVector Candidate = PlayerLocation + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0) * Distance;
+
+		const bool bNearOtherPlayer = PlayerLocations.ContainsByPredicate([&Candidate, MinSpawnDistanceSquared](const FVector& OtherLocation)
+		{
+			return FVector::DistSquared2D(Candidate, OtherLocation) < MinSpawnDistanceSquared;
+		});
+		if (bNearOtherPlayer) continue;
+
+		FNavLocation NavLocation;
+		if (NavSystem->ProjectPointToNavigation(Candidate, NavLocation, FVector(200.f, 200.f, 1000.f)))
+		{
+			OutLocation = NavLocation.Location + FVector(0.f, 0.f, HalfHeight);
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -2,18 +2,50 @@
 
 
 #include "HUD/HealthBarComponent.h"
-#include "HUD/HealthBar.h"
-#include "Components/ProgressBar.h"
+#include "HUD/HealthBarSubsystem.h"
+#include "Engine/World.h"
 
 void UHealthBarComponent::SetHealthPercent(float Percent)
 {
-	if (HealthBarWidget == nullptr)
+	if (BarIndex == INDEX_NONE) return;
+
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
 	{
-		HealthBarWidget = Cast<UHealthBar>(GetUserWidgetObject());
+		HealthBars->SetPercent(BarIndex, Percent);
 	}
+}
+
+void UHealthBarComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+	{
+		HealthBars->RegisterBar(this);
+	}
+}
+
+void UHealthBarComponent::OnUnregister()
+{
+	if (BarIndex != INDEX_NONE)
+	{
+		if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
+		{
+			HealthBars->UnregisterBar(this);
+		}
+	}
+
+	Super::OnUnregister();
+}
+
+void UHealthBarComponent::OnVisibilityChanged()
+{
+	Super::OnVisibilityChanged();
+
+	if (BarIndex == INDEX_NONE) return;
 
-	if (HealthBarWidget && HealthBarWidget->HealthBar)
+	if (UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>())
 	{
-		HealthBarWidget->HealthBar->SetPercent(Percent);
+		HealthBars->SetVisible(BarIndex, IsVisible());
 	}
 }
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HUD/HealthBarSubsystem.h"
+#include "HUD/HealthBarComponent.h"
+#include "GameFramework/Actor.h"
+
+void UHealthBarSubsystem::RegisterBar(UHealthBarComponent* Component)
+{
+	if (Component == nullptr || Component->BarIndex != INDEX_NONE) return;
+
+	Component->BarIndex = Entries.Add({ Component->GetComponentLocation(), 1.f, Component->IsVisible() });
+	Components.Add(Component);
+}
+
+void UHealthBarSubsystem::UnregisterBar(UHealthBarComponent* Component)
+{
+	const int32 Index = Component ? Component->BarIndex : INDEX_NONE;
+	if (!Components.IsValidIndex(Index) || Components[Index] != Component) return;
+
+	Entries.RemoveAtSwap(Index, 1, false);
+	Components.RemoveAtSwap(Index, 1, false);
+	if (Components.IsValidIndex(Index))
+	{
+		Components[Index]->BarIndex = Index;
+	}
+	Component->BarIndex = INDEX_NONE;
+}
+
+void UHealthBarSubsystem::GatherDrawnBars(TArray<FHealthBarEntry>& OutBars) const
+{
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		// Bars at full health or empty aren't drawn
+		const FHealthBarEntry& Entry = Entries[Index];
+		if (!Entry.bVisible || Entry.Percent <= 0.f || Entry.Percent >= 1.f) continue;
+
+		const UHealthBarComponent* Component = Components[Index];
+		const AActor* Owner = Component->GetOwner();
+		if (Owner && Owner->IsHidden()) continue;
+
+		OutBars.Add({ Component->GetComponentLocation(), Entry.Percent, true });
+	}
+}
+
+bool UHealthBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
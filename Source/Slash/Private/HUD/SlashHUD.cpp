@@ -3,6 +3,8 @@
 
 #include "HUD/SlashHUD.h"
 #include "HUD/SlashOverlay.h"
+#include "Engine/Canvas.h"
+#include "Slash/SlashStats.h"
 
 void ASlashHUD::BeginPlay()
 {
@@ -19,3 +21,61 @@ void ASlashHUD::BeginPlay()
 		}
 	}
 }
+
+void ASlashHUD::DrawHUD()
+{
+	Super::DrawHUD();
+
+	DrawHealthBars();
+}
+
+void ASlashHUD::DrawHealthBars()
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashHealthBars);
+	const UHealthBarSubsystem* HealthBars = GetWorld()->GetSubsystem<UHealthBarSubsystem>();
+	if (HealthBars == nullptr || Canvas == nullptr || PlayerOwner == nullptr) return;
+
+	DrawnBars.Reset();
+	HealthBars->GatherDrawnBars(DrawnBars);
+	if (DrawnBars.Num() == 0) return;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerOwner->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const double Scale = Canvas->ClipY / 1080.0;
+	const FVector2D Size = HealthBarSize * Scale;
+
+	// Screen space culling, the projected location replaces the world one and Z holds the distance
+	for (int32 Index = DrawnBars.Num() - 1; Index >= 0; --Index)
+	{
+		FHealthBarEntry& Bar = DrawnBars[Index];
+		const double DistanceSquared = FVector::DistSquared(Bar.WorldLocation, ViewLocation);
+		const FVector ScreenLocation = Project(Bar.WorldLocation, true);
+		const bool bOnScreen = ScreenLocation.Z > 0.0 &&
+			ScreenLocation.X >= -Size.X && ScreenLocation.X <= Canvas->ClipX + Size.X &&
+			ScreenLocation.Y >= -Size.Y && ScreenLocation.Y <= Canvas->ClipY + Size.Y;
+
+		if (!bOnScreen || DistanceSquared > FMath::Square(HealthBarMaxDistance))
+		{
+			DrawnBars.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+		Bar.WorldLocation = FVector(ScreenLocation.X, ScreenLocation.Y, DistanceSquared);
+	}
+
+	if (DrawnBars.Num() > MaxVisibleHealthBars)
+	{
+		DrawnBars.Sort([](const FHealthBarEntry& A, const FHealthBarEntry& B) { return A.WorldLocation.Z < B.WorldLocation.Z; });
+		DrawnBars.SetNum(MaxVisibleHealthBars, false);
+	}
+
+	// All tiles use the white texture, so the canvas batches them into a single draw
+	for (const FHealthBarEntry& Bar : DrawnBars)
+	{
+		const double Left = Bar.WorldLocation.X - Size.X * 0.5;
+		const double Top = Bar.WorldLocation.Y - Size.Y * 0.5;
+		DrawRect(HealthBarBackgroundColor, Left, Top, Size.X, Size.Y);
+		DrawRect(HealthBarColor, Left, Top, Size.X * Bar.Percent, Size.Y);
+	}
+}
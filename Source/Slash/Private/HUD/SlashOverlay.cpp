@@ -4,9 +4,12 @@
 #include "HUD/SlashOverlay.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
+#include "Components/AttributeComponent.h"
+#include "Slash/SlashStats.h"
 
 void USlashOverlay::SetHealthBarPercent(float Percent)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashOverlayUpdate);
 	if (HealthProgressBar)
 	{
 		HealthProgressBar->SetPercent(Percent);
@@ -15,6 +18,7 @@ void USlashOverlay::SetHealthBarPercent(float Percent)
 
 void USlashOverlay::SetStaminaBarPercent(float Percent)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashOverlayUpdate);
 	if (StaminaProgressBar)
 	{
 		StaminaProgressBar->SetPercent(Percent);
@@ -23,6 +27,7 @@ void USlashOverlay::SetStaminaBarPercent(float Percent)
 
 void USlashOverlay::SetGoldCount(int32 Gold)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashOverlayUpdate);
 	if (GoldCountText)
 	{
 		GoldCountText->SetText(FText::FromString(FString::Printf(TEXT("%d"), Gold)));
@@ -31,8 +36,40 @@ void USlashOverlay::SetGoldCount(int32 Gold)
 
 void USlashOverlay::SetSoulsCount(int32 Souls)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashOverlayUpdate);
 	if (SoulsCountText)
 	{
 		SoulsCountText->SetText(FText::FromString(FString::Printf(TEXT("%d"), Souls)));
 	}
 }
+
+void USlashOverlay::BindAttributes(UAttributeComponent* Attributes)
+{
+	UnbindAttributes();
+	if (Attributes == nullptr) return;
+
+	BoundAttributes = Attributes;
+	Attributes->OnHealthChanged.AddUObject(this, &USlashOverlay::SetHealthBarPercent);
+	Attributes->OnStaminaChanged.AddUObject(this, &USlashOverlay::SetStaminaBarPercent);
+	Attributes->OnGoldChanged.AddUObject(this, &USlashOverlay::SetGoldCount);
+	Attributes->OnSoulsChanged.AddUObject(this, &USlashOverlay::SetSoulsCount);
+	Attributes->BroadcastAll();
+}
+
+void USlashOverlay::UnbindAttributes()
+{
+	if (UAttributeComponent* Attributes = BoundAttributes.Get())
+	{
+		Attributes->OnHealthChanged.RemoveAll(this);
+		Attributes->OnStaminaChanged.RemoveAll(this);
+		Attributes->OnGoldChanged.RemoveAll(this);
+		Attributes->OnSoulsChanged.RemoveAll(this);
+	}
+	BoundAttributes.Reset();
+}
+
+void USlashOverlay::NativeDestruct()
+{
+	UnbindAttributes();
+	Super::NativeDestruct();
+}
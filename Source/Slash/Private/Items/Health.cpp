@@ -6,6 +6,8 @@
 
 void AHealth::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (!HasAuthority()) return;
+
 	IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor);
 	if (PickupInterface)
 	{
@@ -13,10 +15,16 @@ void AHealth::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 
 		if (HealthAdded)
 		{
-			SpawnPickupSystem();
-			SpawnPickupSound();
+			MulticastPickupEffects(GetActorLocation());
 
-			Destroy();
+			ReturnToPool();
 		}
 	}
 }
+
+void AHealth::OnAcquiredFromPool()
+{
+	Super::OnAcquiredFromPool();
+
+	HealthAmount = GetClass()->GetDefaultObject<AHealth>()->HealthAmount;
+}
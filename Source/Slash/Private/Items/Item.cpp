@@ -8,6 +8,8 @@
 #include "Interfaces/PickupInterface.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
+#include "Items/ItemPoolSubsystem.h"
+#include "Slash/SlashStats.h"
 
 // Sets default values
 AItem::AItem()
@@ -15,6 +17,9 @@ AItem::AItem()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Spawned and picked up on the server
+	bReplicates = true;
+
 	ItemMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ItemMeshComponent"));
 	ItemMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
 	ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -36,6 +41,45 @@ void AItem::BeginPlay()
 	Sphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
 }
 
+void AItem::OnAcquiredFromPool()
+{
+	RunningTime = 0.f;
+	ItemState = EItemState::EIS_NoState;
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	if (ItemEffect)
+	{
+		ItemEffect->Activate(true);
+	}
+}
+
+void AItem::MulticastAcquiredFromPool_Implementation(FVector_NetQuantize Location, FRotator Rotation)
+{
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	OnAcquiredFromPool();
+}
+
+void AItem::MulticastReleasedToPool_Implementation()
+{
+	OnReleasedToPool();
+}
+
+void AItem::OnReleasedToPool()
+{
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	SetOwner(nullptr);
+
+	if (ItemEffect)
+	{
+		ItemEffect->Deactivate();
+	}
+}
+
 float AItem::TransformedSine()
 {
 	return Amplitude * FMath::Sin(RunningTime * TimeConstant);
@@ -64,33 +108,50 @@ void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 	}
 }
 
-void AItem::SpawnPickupSystem()
+void AItem::MulticastPickupEffects_Implementation(FVector_NetQuantize Location)
+{
+	PlayPickupEffects(Location);
+}
+
+void AItem::PlayPickupEffects(const FVector& Location)
+{
+	SpawnPickupSystem(Location);
+	SpawnPickupSound(Location);
+}
+
+void AItem::SpawnPickupSystem(const FVector& Location)
 {
 	if (PickupEffect)
 	{
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
 			this,
 			PickupEffect,
-			GetActorLocation()
+			Location
 		);
 	}
 }
 
-void AItem::SpawnPickupSound()
+void AItem::SpawnPickupSound(const FVector& Location)
 {
 	if (PickupSound)
 	{
 		UGameplayStatics::SpawnSoundAtLocation(
 			this,
 			PickupSound,
-			GetActorLocation()
+			Location
 		);
 	}
 }
 
+void AItem::ReturnToPool()
+{
+	UItemPoolSubsystem::ReleaseOrDestroy(this);
+}
+
 // Called every frame
 void AItem::Tick(float DeltaTime)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashItemTick);
 	Super::Tick(DeltaTime);
 
 	RunningTime += DeltaTime;
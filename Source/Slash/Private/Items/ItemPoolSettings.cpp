@@ -0,0 +1,9 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/ItemPoolSettings.h"
+
+UItemPoolSettings::UItemPoolSettings()
+{
+	CategoryName = TEXT("Game");
+}
@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/ItemPoolSubsystem.h"
+#include "Items/Item.h"
+#include "Items/ItemPoolSettings.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Slash.h"
+
+void UItemPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Items are spawned by the server and replicated, clients never acquire from the pools
+	if (InWorld.GetNetMode() == NM_Client) return;
+
+	for (const TPair<TSoftClassPtr<AItem>, int32>& PrewarmCount : GetDefault<UItemPoolSettings>()->PrewarmCounts)
+	{
+		if (UClass* ItemClass = PrewarmCount.Key.LoadSynchronous())
+		{
+			Prewarm(ItemClass, PrewarmCount.Value);
+		}
+	}
+}
+
+void UItemPoolSubsystem::Deinitialize()
+{
+	if (GetDefault<UItemPoolSettings>()->bLogStatsOnShutdown && Pools.Num() > 0)
+	{
+		LogStats();
+	}
+
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+AItem* UItemPoolSubsystem::Acquire(TSubclassOf<AItem> ItemClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner)
+{
+	if (ItemClass == nullptr) return nullptr;
+
+	FItemPool& Pool = Pools.FindOrAdd(ItemClass);
+
+	AItem* Item = nullptr;
+	while (Pool.FreeItems.Num() > 0 && Item == nullptr)
+	{
+		Item = Pool.FreeItems.Pop(false);
+		if (!IsValid(Item)) Item = nullptr;
+	}
+
+	if (Item)
+	{
+		++Pool.Hits;
+		Item->bInPool = false;
+		Item->SetOwner(NewOwner);
+		Item->MulticastAcquiredFromPool(Location, Rotation);
+	}
+	else
+	{
+		++Pool.Misses;
+		Item = SpawnItem(ItemClass, Location, Rotation, NewOwner);
+		if (Item == nullptr) return nullptr;
+	}
+
+	Item->bFromPool = true;
+	Pool.NumActive++;
+	Pool.PeakActive = FMath::Max(Pool.PeakActive, Pool.NumActive);
+	return Item;
+}
+
+void UItemPoolSubsystem::Release(AItem* Item)
+{
+	if (!IsValid(Item) || Item->bInPool) return;
+
+	FItemPool& Pool = Pools.FindOrAdd(Item->GetClass());
+	if (Item->bFromPool)
+	{
+		Pool.NumActive = FMath::Max(Pool.NumActive - 1, 0);
+	}
+
+	// Items placed in the level are adopted, so the next acquire doesn't need to spawn
+	Item->bFromPool = false;
+	Item->bInPool = true;
+	Item->MulticastReleasedToPool();
+	Pool.FreeItems.Add(Item);
+}
+
+void UItemPoolSubsystem::Prewarm(TSubclassOf<AItem> ItemClass, int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || ItemClass == nullptr) return;
+
+	FItemPool& Pool = Pools.FindOrAdd(ItemClass);
+	for (int32 Index = Pool.FreeItems.Num(); Index < Count; ++Index)
+	{
+		if (AItem* Item = SpawnItem(ItemClass, FVector::ZeroVector, FRotator::ZeroRotator, nullptr))
+		{
+			// Hidden without collision before it was ever relevant, clients don't get it until it's acquired
+			Item->bInPool = true;
+			Item->OnReleasedToPool();
+			Pool.FreeItems.Add(Item);
+		}
+	}
+}
+
+void UItemPoolSubsystem::LogStats() const
+{
+	for (const TPair<UClass*, FItemPool>& Pair : Pools)
+	{
+		const FItemPool& Pool = Pair.Value;
+		UE_LOG(LogSlash, Display, TEXT("ItemPool %s: hits %d, misses %d, active %d, peak %d, free %d"),
+			*GetNameSafe(Pair.Key), Pool.Hits, Pool.Misses, Pool.NumActive, Pool.PeakActive, Pool.FreeItems.Num());
+	}
+}
+
+void UItemPoolSubsystem::ReleaseOrDestroy(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	UWorld* World = Item->GetWorld();
+	if (UItemPoolSubsystem* ItemPool = World ? World->GetSubsystem<UItemPoolSubsystem>() : nullptr)
+	{
+		ItemPool->Release(Item);
+	}
+	else
+	{
+		Item->Destroy();
+	}
+}
+
+bool UItemPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AItem* UItemPoolSubsystem::SpawnItem(UClass* ItemClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = NewOwner;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AItem>(ItemClass, Location, Rotation, SpawnParams);
+}
+
+static FAutoConsoleCommandWithWorld ItemPoolStatsCommand(
+	TEXT("Slash.ItemPool.Stats"),
+	TEXT("Logs hit/miss counts and peak occupancy of the item pools."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UItemPoolSubsystem* ItemPool = World ? World->GetSubsystem<UItemPoolSubsystem>() : nullptr)
+		{
+			ItemPool->LogStats();
+		}
+	}));
@@ -4,6 +4,7 @@
 #include "Items/Soul.h"
 #include "Interfaces/PickupInterface.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Slash/SlashStats.h"
 
 void ASoul::Tick(float DeltaTime)
 {
@@ -17,12 +18,25 @@ void ASoul::Tick(float DeltaTime)
 	}
 }
 
+void ASoul::OnAcquiredFromPool()
+{
+	Super::OnAcquiredFromPool();
+
+	ItemState = EItemState::EIS_Hovering;
+	UpdateDesiredZ();
+}
+
 void ASoul::BeginPlay()
 {
 	Super::BeginPlay();
 
 	ItemState = EItemState::EIS_Hovering;
+	UpdateDesiredZ();
+}
 
+void ASoul::UpdateDesiredZ()
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashSoulGroundTrace);
 	const FVector Start = GetActorLocation();
 	const FVector End = Start - FVector(0.f, 0.f, 2000.f);
 
@@ -34,6 +48,7 @@ void ASoul::BeginPlay()
 
 	FHitResult HitResult;
 
+	SLASH_COUNT_TRACE();
 	UKismetSystemLibrary::LineTraceSingleForObjects(
 		this, 
 		Start, 
@@ -50,13 +65,14 @@ void ASoul::BeginPlay()
 
 void ASoul::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (!HasAuthority()) return;
+
 	IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor);
 	if (PickupInterface)
 	{
 		PickupInterface->AddSouls(this);
-		SpawnPickupSystem();
-		SpawnPickupSound();
+		MulticastPickupEffects(GetActorLocation());
 
-		Destroy();
+		ReturnToPool();
 	}
 }
@@ -6,12 +6,26 @@
 
 void ATreasure::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (!HasAuthority()) return;
+
 	IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor);
 	if (PickupInterface)
 	{
 		PickupInterface->AddGold(this);
-		SpawnPickupSound();
+		MulticastPickupEffects(GetActorLocation());
 
-		Destroy();
+		ReturnToPool();
 	}
 }
+
+void ATreasure::PlayPickupEffects(const FVector& Location)
+{
+	SpawnPickupSound(Location);
+}
+
+void ATreasure::OnAcquiredFromPool()
+{
+	Super::OnAcquiredFromPool();
+
+	Gold = GetClass()->GetDefaultObject<ATreasure>()->Gold;
+}
@@ -7,17 +7,32 @@
 #include "Components/SphereComponent.h"
 #include "Components/BoxComponent.h"
 #include "NiagaraComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Interfaces/HitInterface.h"
+#include "Components/FactionComponent.h"
+#include "Combat/CombatTraceSubsystem.h"
+#include "Combat/CombatEventSubsystem.h"
+#include "Combat/HitDirectionClassifier.h"
+#include "Slash/SlashStats.h"
+#include "Slash.h"
+#include "DrawDebugHelpers.h"
+#include "UObject/ObjectSaveContext.h"
 
 AWeapon::AWeapon()
 {
+	// Sweeps read the blade after the owner's animation has been evaluated
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
 	WeaponBox = CreateDefaultSubobject<UBoxComponent>(TEXT("WeaponBox"));
 	WeaponBox->SetupAttachment(GetRootComponent());
 	WeaponBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	WeaponBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
 	WeaponBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
 
+	// Character meshes are WorldDynamic, their capsules are left out so hits land on the mesh
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldDynamic);
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_PhysicsBody);
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Destructible);
+
 	BoxTraceStart = CreateDefaultSubobject<USceneComponent>(TEXT("Box Trace Start"));
 	BoxTraceStart->SetupAttachment(GetRootComponent());
 
@@ -32,11 +47,74 @@ void AWeapon::BeginPlay()
 	WeaponBox->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::OnBoxOverlap);
 }
 
+void AWeapon::PostLoad()
+{
+	Super::PostLoad();
+
+	ResolveLegacyWeaponData();
+}
+
+void AWeapon::PostActorCreated()
+{
+	Super::PostActorCreated();
+
+	ResolveLegacyWeaponData();
+}
+
+#if WITH_EDITOR
+void AWeapon::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// Deprecated properties aren't cooked, a cooked weapon without an asset falls back to the asset defaults
+	if (ObjectSaveContext.IsCooking() && WeaponData == nullptr && LegacyWeaponData)
+	{
+		UE_LOG(LogSlash, Error, TEXT("%s has no WeaponData and cooks with the defaults, run Slash.Weapons.MigrateData and save its assets"), *GetPathName());
+	}
+}
+#endif
+
+void AWeapon::ResolveLegacyWeaponData()
+{
+#if WITH_EDITORONLY_DATA
+	if (WeaponData || LegacyWeaponData || WeaponType_DEPRECATED.IsEmpty()) return;
+
+	// Same values as the blueprint, share its copy like the migration would share its asset
+	AWeapon* Archetype = HasAnyFlags(RF_ClassDefaultObject) ? nullptr : Cast<AWeapon>(GetArchetype());
+	if (Archetype && Archetype->WeaponData == nullptr &&
+		Archetype->WeaponType_DEPRECATED == WeaponType_DEPRECATED && Archetype->Damage_DEPRECATED == Damage_DEPRECATED &&
+		Archetype->BoxTraceExtent_DEPRECATED == BoxTraceExtent_DEPRECATED && Archetype->EquipSound_DEPRECATED == EquipSound_DEPRECATED)
+	{
+		Archetype->ResolveLegacyWeaponData();
+		LegacyWeaponData = Archetype->LegacyWeaponData;
+		return;
+	}
+
+	LegacyWeaponData = NewObject<UWeaponDataAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+	LegacyWeaponData->WeaponType = WeaponType_DEPRECATED == TEXT("Two-Handed") ? EWeaponType::EWT_TwoHanded : EWeaponType::EWT_OneHanded;
+	LegacyWeaponData->SheathSocket = LegacyWeaponData->WeaponType == EWeaponType::EWT_TwoHanded ? FName("NeckSocket") : FName("ThighSocket");
+	LegacyWeaponData->Damage = Damage_DEPRECATED;
+	LegacyWeaponData->BoxTraceExtent = BoxTraceExtent_DEPRECATED;
+	LegacyWeaponData->EquipSound = EquipSound_DEPRECATED;
+#endif
+}
+
+void AWeapon::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bSwinging)
+	{
+		SweepBlade();
+	}
+}
+
 void AWeapon::Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator)
 {
 	ItemState = EItemState::EIS_Equipped;
 	SetOwner(NewOwner);
 	SetInstigator(NewInstigator);
+	ResetSwingState();
 	AttachMeshToSocket(InParent, InSocketName);
 	DisableSphereCollision();
 	DeactivateGlowEffect();
@@ -60,7 +138,7 @@ void AWeapon::DisableSphereCollision()
 
 void AWeapon::PlayEquipSound()
 {
-	if (EquipSound)
+	if (USoundBase* EquipSound = GetWeaponData()->EquipSound)
 	{
 		UGameplayStatics::PlaySoundAtLocation(this, EquipSound, GetActorLocation());
 	}
@@ -68,6 +146,7 @@ void AWeapon::PlayEquipSound()
 
 void AWeapon::Unequip(USceneComponent* InParent, FName InSocketName)
 {
+	ResetSwingState();
 	AttachMeshToSocket(InParent, InSocketName);
 }
 
@@ -77,6 +156,69 @@ void AWeapon::AttachMeshToSocket(USceneComponent* InParent, const FName& InSocke
 	ItemMesh->AttachToComponent(InParent, TransformRules, InSocketName);
 }
 
+void AWeapon::SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled)
+{
+	// Only the server traces and applies hits, clients see them through hit reacts and replicated attributes
+	if (!HasAuthority()) return;
+
+	// Hits are only forgotten when the next swing starts. Async results of the last one may still be in flight,
+	// they are resolved against its own hits when they come back
+	if (CollisionEnabled != ECollisionEnabled::NoCollision)
+	{
+		PreviousSwingHits = SwingHits;
+		bResolvePreviousSwing = true;
+		ClearSwingHits();
+	}
+
+	if (bUseSweptTracing)
+	{
+		if (CollisionEnabled == ECollisionEnabled::NoCollision)
+		{
+			EndSwing();
+		}
+		else
+		{
+			BeginSwing();
+		}
+	}
+	else
+	{
+		WeaponBox->SetCollisionEnabled(CollisionEnabled);
+	}
+}
+
+void AWeapon::OnAcquiredFromPool()
+{
+	Super::OnAcquiredFromPool();
+
+	if (Sphere)
+	{
+		Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	}
+}
+
+void AWeapon::OnReleasedToPool()
+{
+	Super::OnReleasedToPool();
+
+	ItemState = EItemState::EIS_NoState;
+	SetInstigator(nullptr);
+	ResetSwingState();
+	ItemMesh->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+}
+
+void AWeapon::OnRep_Owner()
+{
+	Super::OnRep_Owner();
+
+	// Equip runs on the server, clients stop offering the weapon as a pickup once it has an owner
+	if (GetOwner())
+	{
+		DisableSphereCollision();
+		DeactivateGlowEffect();
+	}
+}
+
 void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	if (ActorIsSameType(OtherActor)) return;
@@ -84,56 +226,243 @@ void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Oth
 	FHitResult BoxHit;
 	BoxTrace(BoxHit);
 
-	if (BoxHit.GetActor())
+	// The trace may find someone other than OtherActor, allies are skipped before they take a cleave slot
+	AActor* HitTarget = BoxHit.GetActor();
+	if (HitTarget == nullptr || UFactionComponent::IsDead(HitTarget)) return;
+
+	if (ActorIsSameType(HitTarget))
 	{
-		if (ActorIsSameType(BoxHit.GetActor())) return;
+		SwingQueryParams.AddIgnoredActor(HitTarget);
+		return;
+	}
 
-		UGameplayStatics::ApplyDamage(BoxHit.GetActor(), Damage, GetInstigator()->GetController(), this, UDamageType::StaticClass());
-		ExecuteGetHit(BoxHit);
-		CreateFields(BoxHit.ImpactPoint);
+	if (TryRecordSwingHit(HitTarget))
+	{
+		HitActor(BoxHit);
 	}
 }
 
 bool AWeapon::ActorIsSameType(AActor* OtherActor)
 {
-	return GetOwner()->ActorHasTag(TEXT("Enemy")) && OtherActor->ActorHasTag(TEXT("Enemy"));
+	return UFactionComponent::AreFriendly(GetOwner(), OtherActor);
+}
+
+void AWeapon::ResetSwingState()
+{
+	bResolvePreviousSwing = false;
+	ClearSwingHits();
+	WeaponBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	bSwinging = false;
+}
+
+void AWeapon::ClearSwingHits()
+{
+	SwingHits.BeginSwing(MaxCleaveTargets, RehitCooldown);
+	SwingQueryParams.ClearIgnoredActors();
+	SwingQueryParams.AddIgnoredActor(this);
+	SwingQueryParams.AddIgnoredActor(GetOwner());
+}
+
+bool AWeapon::TryRecordSwingHit(AActor* HitTarget)
+{
+	return TryRecordSwingHit(SwingHits, HitTarget);
+}
+
+bool AWeapon::TryRecordSwingHit(FSwingHitRegistry& Registry, AActor* HitTarget)
+{
+	if (!Registry.TryRegisterHit(HitTarget, GetWorld()->GetTimeSeconds())) return false;
+
+	// Targets that can't be hit again this swing are dropped from the traces altogether, the current swing's only
+	if (&Registry == &SwingHits && !SwingHits.AllowsRehits())
+	{
+		SwingQueryParams.AddIgnoredActor(HitTarget);
+	}
+	return true;
 }
 
 void AWeapon::BoxTrace(FHitResult& BoxHit)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashWeaponBoxTrace);
 	const FVector Start = BoxTraceStart->GetComponentLocation();
 	const FVector End = BoxTraceEnd->GetComponentLocation();
+	const FQuat Rotation = BoxTraceStart->GetComponentQuat();
+	const FVector BoxTraceExtent = GetWeaponData()->BoxTraceExtent;
 
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(this);
-	ActorsToIgnore.Add(GetOwner());
+	SLASH_COUNT_TRACE();
+	GetWorld()->SweepSingleByObjectType(BoxHit, Start, End, Rotation, SwingObjectParams, FCollisionShape::MakeBox(BoxTraceExtent), SwingQueryParams);
 
-	for (AActor* Actor : IgnoreActors)
+	if (bShowDebugBox)
 	{
-		ActorsToIgnore.AddUnique(Actor);
+		DrawDebugSweptBox(GetWorld(), Start, End, Rotation.Rotator(), BoxTraceExtent, FColor::Red, false, 5.f);
 	}
-
-	UKismetSystemLibrary::BoxTraceSingle(
-		this,
-		Start,
-		End,
-		BoxTraceExtent,
-		BoxTraceStart->GetComponentRotation(),
-		ETraceTypeQuery::TraceTypeQuery1,
-		false,
-		ActorsToIgnore,
-		bShowDebugBox ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		BoxHit,
-		true
-	);
-	IgnoreActors.AddUnique(BoxHit.GetActor());
 }
 
-void AWeapon::ExecuteGetHit(FHitResult& BoxHit)
+void AWeapon::ExecuteGetHit(const FHitResult& BoxHit)
 {
 	IHitInterface* HitInterface = Cast<IHitInterface>(BoxHit.GetActor());
 	if (HitInterface)
 	{
 		IHitInterface::Execute_GetHit(BoxHit.GetActor(), BoxHit.ImpactPoint, GetOwner());
 	}
-}
\ No newline at end of file
+}
+
+void AWeapon::HitActor(const FHitResult& BoxHit)
+{
+	if (ActorIsSameType(BoxHit.GetActor())) return;
+
+	const float Damage = GetWeaponData()->Damage;
+	UCombatEventSubsystem::Record(this, ECombatEventType::ECE_Hit, GetOwner(), BoxHit.GetActor(), Damage, BoxHit.ImpactPoint);
+	UGameplayStatics::ApplyDamage(BoxHit.GetActor(), Damage, GetInstigator()->GetController(), this, UDamageType::StaticClass());
+	ExecuteGetHit(BoxHit);
+	MulticastCreateFields(BoxHit.ImpactPoint);
+}
+
+void AWeapon::MulticastCreateFields_Implementation(FVector_NetQuantize FieldLocation)
+{
+	CreateFields(FieldLocation);
+}
+
+void AWeapon::BeginSwing()
+{
+	bSwinging = true;
+	bReportedSubstepCap = false;
+	BladeSweep.LocalStart = BoxTraceStart->GetRelativeTransform();
+	BladeSweep.LocalEnd = BoxTraceEnd->GetRelativeLocation();
+	PreviousBladeTransform = GetRootComponent()->GetComponentTransform();
+
+	// The first pose is traced right away so a swing that ends within a frame still lands
+	SweepBlade();
+}
+
+void AWeapon::EndSwing()
+{
+	bSwinging = false;
+}
+
+void AWeapon::SweepBlade()
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashWeaponSweep);
+	const FTransform BladeTransform = GetRootComponent()->GetComponentTransform();
+
+	BladeSweep.SetFrame(PreviousBladeTransform, BladeTransform);
+
+	int32 NumSubsteps = BladeSweep.GetNumSubsteps(MaxSubstepDistance);
+	if (NumSubsteps > MaxSubsteps)
+	{
+		// Steps are coarser than MaxSubstepDistance for this frame, thin targets may be tunnelled through again
+		INC_DWORD_STAT(STAT_SlashCappedSweeps);
+		if (!bReportedSubstepCap)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("%s: blade needed %d sub-steps in one frame, capped at %d"), *GetName(), NumSubsteps, MaxSubsteps);
+			bReportedSubstepCap = true;
+		}
+		NumSubsteps = MaxSubsteps;
+	}
+
+	const bool bCanHitMore = !SwingHits.IsCleaveExhausted() || SwingHits.AllowsRehits();
+	FVector Start;
+	FVector End;
+	FQuat Rotation;
+	for (int32 Substep = 1; Substep <= NumSubsteps && bSwinging && bCanHitMore; ++Substep)
+	{
+		BladeSweep.GetPose(static_cast<double>(Substep) / NumSubsteps, Start, End, Rotation);
+		TraceBladePose(Start, End, Rotation);
+	}
+
+	PreviousBladeTransform = BladeTransform;
+}
+
+void AWeapon::TraceBladePose(const FVector& Start, const FVector& End, const FQuat& Rotation)
+{
+	const FVector BoxTraceExtent = GetWeaponData()->BoxTraceExtent;
+	if (bShowDebugBox)
+	{
+		DrawDebugSweptBox(GetWorld(), Start, End, Rotation.Rotator(), BoxTraceExtent, FColor::Red, false, 5.f);
+	}
+
+	SLASH_COUNT_TRACE();
+	UCombatTraceSubsystem* CombatTrace = GetWorld()->GetSubsystem<UCombatTraceSubsystem>();
+	if (CombatTrace && UCombatTraceSubsystem::IsAsyncEnabled())
+	{
+		CombatTrace->QueueWeaponSweep(this, SwingHits.GetSwingId(), Start, End, Rotation, BoxTraceExtent, SwingObjectParams, SwingQueryParams);
+		return;
+	}
+
+	SweepHits.Reset();
+	GetWorld()->SweepMultiByObjectType(SweepHits, Start, End, Rotation, SwingObjectParams, FCollisionShape::MakeBox(BoxTraceExtent), SwingQueryParams);
+	ResolveSweepHits(SwingHits.GetSwingId(), SweepHits);
+}
+
+void AWeapon::ResolveSweepHits(uint32 InSwingId, const TArray<FHitResult>& Hits)
+{
+	// Results of the previous combo swing still count towards that swing, results of a reset weapon don't
+	FSwingHitRegistry* Registry = nullptr;
+	if (InSwingId == SwingHits.GetSwingId())
+	{
+		Registry = &SwingHits;
+	}
+	else if (bResolvePreviousSwing && InSwingId == PreviousSwingHits.GetSwingId())
+	{
+		Registry = &PreviousSwingHits;
+	}
+	if (Registry == nullptr) return;
+
+	const uint32 CurrentSwingId = SwingHits.GetSwingId();
+
+	AcceptedHits.Reset();
+	for (int32 HitIndex = 0; HitIndex < Hits.Num(); ++HitIndex)
+	{
+		AActor* HitTarget = Hits[HitIndex].GetActor();
+		if (HitTarget == nullptr || UFactionComponent::IsDead(HitTarget)) continue;
+
+		// Nothing is blocking any more, so other weapons and props are in the results too. Neither they
+		// nor allies count towards the cleave limit
+		if (!HitTarget->Implements<UHitInterface>() || ActorIsSameType(HitTarget))
+		{
+			SwingQueryParams.AddIgnoredActor(HitTarget);
+			continue;
+		}
+
+		if (TryRecordSwingHit(*Registry, HitTarget))
+		{
+			AcceptedHits.Add(HitIndex);
+		}
+	}
+
+	// Every victim's hit react is picked in one pass before damage moves anyone
+	ClassifyHitDirections(Hits);
+
+	for (int32 Index = 0; Index < AcceptedHits.Num(); ++Index)
+	{
+		const FHitResult& Hit = Hits[AcceptedHits[Index]];
+		if (ABaseCharacter* Victim = Cast<ABaseCharacter>(Hit.GetActor()))
+		{
+			Victim->SetIncomingHitDirection(HitDirections[Index]);
+		}
+
+		// A hit that resets the weapon or starts a new swing ends this resolve
+		HitActor(Hit);
+		if (CurrentSwingId != SwingHits.GetSwingId()) return;
+	}
+}
+
+void AWeapon::ClassifyHitDirections(const TArray<FHitResult>& Hits)
+{
+	const int32 NumAccepted = AcceptedHits.Num();
+	VictimForwards.SetNumUninitialized(NumAccepted, false);
+	VictimLocations.SetNumUninitialized(NumAccepted, false);
+	HitFroms.SetNumUninitialized(NumAccepted, false);
+	HitDirections.SetNumUninitialized(NumAccepted, false);
+
+	// Characters react to where the hitter stands, like ABaseCharacter::GetHit_Implementation
+	const FVector OwnerLocation = GetOwner() ? GetOwner()->GetActorLocation() : GetActorLocation();
+	for (int32 Index = 0; Index < NumAccepted; ++Index)
+	{
+		const AActor* Victim = Hits[AcceptedHits[Index]].GetActor();
+		VictimForwards[Index] = Victim->GetActorForwardVector();
+		VictimLocations[Index] = Victim->GetActorLocation();
+		HitFroms[Index] = OwnerLocation;
+	}
+
+	FHitDirectionClassifier::ClassifyBatch(VictimForwards, VictimLocations, HitFroms, HitDirections);
+}
@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/Weapons/Weapon.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "Slash.h"
+
+/**
+ * One-off editor migration of weapons saved before data assets. Every weapon blueprint and every placed weapon
+ * that still has its own values gets a UWeaponDataAsset next to its blueprint, weapons with the same values share
+ * one. Placed weapons that only inherit their blueprint's values keep inheriting its asset.
+ * Weapons saved by the old load-time migration, with a data asset inside the weapon itself, are moved out too.
+ */
+struct FWeaponDataMigration
+{
+	struct FWeaponValues
+	{
+		EWeaponType WeaponType = EWeaponType::EWT_OneHanded;
+		float Damage = 0.f;
+		FVector BoxTraceExtent = FVector::ZeroVector;
+		USoundBase* EquipSound = nullptr;
+		FName SheathSocket;
+
+		bool operator==(const FWeaponValues& Other) const
+		{
+			return WeaponType == Other.WeaponType && Damage == Other.Damage && BoxTraceExtent == Other.BoxTraceExtent &&
+				EquipSound == Other.EquipSound && SheathSocket == Other.SheathSocket;
+		}
+
+		FString ToKey() const
+		{
+			return FString::Printf(TEXT("%d|%f|%s|%s|%s"), static_cast<int32>(WeaponType), Damage, *BoxTraceExtent.ToString(),
+				*GetPathNameSafe(EquipSound), *SheathSocket.ToString());
+		}
+	};
+
+	static FWeaponValues GetDeprecatedValues(const AWeapon* Weapon)
+	{
+		FWeaponValues Values;
+		Values.WeaponType = Weapon->WeaponType_DEPRECATED == TEXT("Two-Handed") ? EWeaponType::EWT_TwoHanded : EWeaponType::EWT_OneHanded;
+		Values.Damage = Weapon->Damage_DEPRECATED;
+		Values.BoxTraceExtent = Weapon->BoxTraceExtent_DEPRECATED;
+		Values.EquipSound = Weapon->EquipSound_DEPRECATED;
+		Values.SheathSocket = Values.WeaponType == EWeaponType::EWT_TwoHanded ? FName("NeckSocket") : FName("ThighSocket");
+		return Values;
+	}
+
+	static FWeaponValues GetAssetValues(const UWeaponDataAsset* Asset)
+	{
+		FWeaponValues Values;
+		Values.WeaponType = Asset->WeaponType;
+		Values.Damage = Asset->Damage;
+		Values.BoxTraceExtent = Asset->BoxTraceExtent;
+		Values.EquipSound = Asset->EquipSound;
+		Values.SheathSocket = Asset->SheathSocket;
+		return Values;
+	}
+
+	/** Values the weapon still keeps to itself, false if it already uses a shared asset or inherits one */
+	static bool GetOwnValues(const AWeapon* Weapon, FWeaponValues& OutValues)
+	{
+		if (Weapon->WeaponData && Weapon->WeaponData->GetOuter() == Weapon)
+		{
+			OutValues = GetAssetValues(Weapon->WeaponData);
+			return true;
+		}
+
+		if (Weapon->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			if (Weapon->WeaponData || Weapon->WeaponType_DEPRECATED.IsEmpty()) return false;
+
+			OutValues = GetDeprecatedValues(Weapon);
+			return true;
+		}
+
+		// Placed weapons start from their blueprint, only values saved on the instance itself need an asset of their own
+		const AWeapon* Archetype = Cast<AWeapon>(Weapon->GetArchetype());
+		if (Archetype == nullptr || Weapon->WeaponData != Archetype->WeaponData || Weapon->WeaponType_DEPRECATED.IsEmpty()) return false;
+
+		OutValues = GetDeprecatedValues(Weapon);
+		return !(OutValues == GetDeprecatedValues(Archetype));
+	}
+
+	UWeaponDataAsset* FindOrCreateAsset(const FWeaponValues& Values, const UClass* WeaponClass)
+	{
+		const FString Key = Values.ToKey();
+		if (UWeaponDataAsset** Existing = Assets.Find(Key))
+		{
+			return *Existing;
+		}
+
+		// DA_<blueprint name> next to the blueprint, numbered for further variants
+		FString BaseName = WeaponClass->GetName();
+		BaseName.RemoveFromEnd(TEXT("_C"));
+		BaseName.RemoveFromStart(TEXT("BP_"));
+		BaseName = TEXT("DA_") + BaseName;
+		const FString PackagePath = FPackageName::GetLongPackagePath(WeaponClass->GetPackage()->GetName());
+
+		FString AssetName = BaseName;
+		for (int32 Suffix = 1; FPackageName::DoesPackageExist(PackagePath / AssetName) || FindPackage(nullptr, *(PackagePath / AssetName)); ++Suffix)
+		{
+			AssetName = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+		}
+
+		UPackage* Package = CreatePackage(*(PackagePath / AssetName));
+		UWeaponDataAsset* Asset = NewObject<UWeaponDataAsset>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+		Asset->WeaponType = Values.WeaponType;
+		Asset->Damage = Values.Damage;
+		Asset->BoxTraceExtent = Values.BoxTraceExtent;
+		Asset->EquipSound = Values.EquipSound;
+		Asset->SheathSocket = Values.SheathSocket;
+		FAssetRegistryModule::AssetCreated(Asset);
+		Package->MarkPackageDirty();
+		PackagesToSave.Add(Package);
+
+		UE_LOG(LogSlash, Display, TEXT("WeaponData: created %s"), *Asset->GetPathName());
+		Assets.Add(Key, Asset);
+		return Asset;
+	}
+
+	void Migrate(AWeapon* Weapon)
+	{
+		FWeaponValues Values;
+		if (!GetOwnValues(Weapon, Values)) return;
+
+		// The old load-time copy isn't saved with the weapon again
+		if (Weapon->WeaponData && Weapon->WeaponData->GetOuter() == Weapon)
+		{
+			Weapon->WeaponData->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+		}
+
+		Weapon->Modify();
+		Weapon->WeaponData = FindOrCreateAsset(Values, Weapon->GetClass());
+		PackagesToSave.Add(Weapon->GetPackage());
+		++NumMigrated;
+
+		UE_LOG(LogSlash, Display, TEXT("WeaponData: %s uses %s"), *Weapon->GetPathName(), *Weapon->WeaponData->GetName());
+	}
+
+	void Run()
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		TSet<FTopLevelAssetPath> WeaponClassPaths;
+		AssetRegistry.GetDerivedClassNames({ AWeapon::StaticClass()->GetClassPathName() }, {}, WeaponClassPaths);
+
+		// Blueprints first, so placed weapons are compared against their migrated defaults
+		FARFilter Filter;
+		for (const FTopLevelAssetPath& ClassPath : WeaponClassPaths)
+		{
+			UClass* WeaponClass = LoadObject<UClass>(nullptr, *ClassPath.ToString());
+			if (WeaponClass == nullptr || WeaponClass->HasAnyClassFlags(CLASS_Native)) continue;
+
+			Migrate(WeaponClass->GetDefaultObject<AWeapon>());
+			Filter.ClassPaths.Add(ClassPath);
+		}
+
+		// Maps hold their own placed actors, One File Per Actor levels keep them in external actor packages
+		Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+		Filter.PackagePaths.Add(TEXT("/Game"));
+		Filter.bRecursivePaths = true;
+		Filter.bIncludeOnlyOnDiskAssets = true;
+
+		TArray<FAssetData> Packages;
+		AssetRegistry.GetAssets(Filter, Packages);
+		for (const FAssetData& Asset : Packages)
+		{
+			UPackage* Package = LoadPackage(nullptr, *Asset.PackageName.ToString(), LOAD_None);
+			if (Package == nullptr) continue;
+
+			ForEachObjectWithPackage(Package, [this](UObject* Object)
+			{
+				if (AWeapon* Weapon = Cast<AWeapon>(Object))
+				{
+					if (!Weapon->HasAnyFlags(RF_ArchetypeObject))
+					{
+						Migrate(Weapon);
+					}
+				}
+				return true;
+			});
+		}
+
+		if (PackagesToSave.Num() > 0)
+		{
+			UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave.Array(), true);
+		}
+		UE_LOG(LogSlash, Display, TEXT("WeaponData: migrated %d weapons to %d data assets, saved %d packages"), NumMigrated, Assets.Num(), PackagesToSave.Num());
+	}
+
+	TMap<FString, UWeaponDataAsset*> Assets;
+	TSet<UPackage*> PackagesToSave;
+	int32 NumMigrated = 0;
+};
+
+static FAutoConsoleCommand MigrateWeaponDataCommand(
+	TEXT("Slash.Weapons.MigrateData"),
+	TEXT("Editor only: moves the values of weapons saved before data assets into shared UWeaponDataAssets and saves the changed packages."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FWeaponDataMigration Migration;
+		Migration.Run();
+	}));
+
+#endif
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Network/NetBandwidthSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Slash.h"
+
+static TAutoConsoleVariable<float> CVarNetStatsInterval(
+	TEXT("Slash.Net.StatsInterval"),
+	1.f,
+	TEXT("Seconds between bandwidth samples of each net connection."),
+	ECVF_Default);
+
+void UNetBandwidthSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	StartTime = LastSampleTime = FPlatformTime::Seconds();
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("SlashNetStats")))
+	{
+		ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("NetBandwidth-%s"), *FDateTime::Now().ToString());
+		Csv = TEXT("Seconds,Player,OutBytesPerSecond,InBytesPerSecond\n");
+	}
+}
+
+void UNetBandwidthSubsystem::Deinitialize()
+{
+	if (!ReportPath.IsEmpty())
+	{
+		WriteReport();
+	}
+
+	Super::Deinitialize();
+}
+
+void UNetBandwidthSubsystem::Tick(float DeltaTime)
+{
+	// Wall clock, rates are what goes over the wire whatever the frame rate
+	if (FPlatformTime::Seconds() - LastSampleTime >= CVarNetStatsInterval.GetValueOnGameThread())
+	{
+		Sample();
+	}
+}
+
+TStatId UNetBandwidthSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNetBandwidthSubsystem, STATGROUP_Tickables);
+}
+
+bool UNetBandwidthSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UNetBandwidthSubsystem::Sample()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Interval = Now - LastSampleTime;
+	LastSampleTime = Now;
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr || Interval <= 0.0) return;
+
+	if (NetDriver->ServerConnection)
+	{
+		SampleConnection(NetDriver->ServerConnection, Interval);
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		SampleConnection(Connection, Interval);
+	}
+}
+
+void UNetBandwidthSubsystem::SampleConnection(UNetConnection* Connection, double Interval)
+{
+	if (Connection == nullptr) return;
+
+	const uint64 OutBytes = static_cast<uint64>(Connection->OutTotalBytes);
+	const uint64 InBytes = static_cast<uint64>(Connection->InTotalBytes);
+
+	FConnectionStats* Stats = Connections.Find(Connection);
+	if (Stats == nullptr)
+	{
+		// Counted from the first sample on, the handshake before it isn't gameplay traffic
+		Stats = &Connections.Add(Connection);
+		Stats->LastOutBytes = OutBytes;
+		Stats->LastInBytes = InBytes;
+		return;
+	}
+
+	if (Connection == Connection->Driver->ServerConnection)
+	{
+		Stats->PlayerName = TEXT("Server");
+	}
+	else if (Connection->PlayerController && Connection->PlayerController->PlayerState)
+	{
+		Stats->PlayerName = Connection->PlayerController->PlayerState->GetPlayerName();
+	}
+	else if (Stats->PlayerName.IsEmpty())
+	{
+		Stats->PlayerName = Connection->LowLevelGetRemoteAddress(true);
+	}
+
+	const uint64 OutDelta = OutBytes >= Stats->LastOutBytes ? OutBytes - Stats->LastOutBytes : 0;
+	const uint64 InDelta = InBytes >= Stats->LastInBytes ? InBytes - Stats->LastInBytes : 0;
+	Stats->LastOutBytes = OutBytes;
+	Stats->LastInBytes = InBytes;
+	Stats->TotalOutBytes += OutDelta;
+	Stats->TotalInBytes += InDelta;
+	Stats->Seconds += Interval;
+	Stats->OutBytesPerSecond = OutDelta / Interval;
+	Stats->InBytesPerSecond = InDelta / Interval;
+	Stats->PeakOutBytesPerSecond = FMath::Max(Stats->PeakOutBytesPerSecond, Stats->OutBytesPerSecond);
+
+	if (!ReportPath.IsEmpty())
+	{
+		Csv += FString::Printf(TEXT("%.2f,%s,%.0f,%.0f\n"), LastSampleTime - StartTime, *Stats->PlayerName, Stats->OutBytesPerSecond, Stats->InBytesPerSecond);
+	}
+}
+
+void UNetBandwidthSubsystem::LogRates() const
+{
+	int32 NumLogged = 0;
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionStats>& Pair : Connections)
+	{
+		const FConnectionStats& Stats = Pair.Value;
+		if (!Pair.Key.ResolveObjectPtr() || Stats.Seconds <= 0.0) continue;
+
+		UE_LOG(LogSlash, Display, TEXT("Net: %s out %.2f KB/s (peak %.2f) in %.2f KB/s"),
+			*Stats.PlayerName, Stats.OutBytesPerSecond / 1024.0, Stats.PeakOutBytesPerSecond / 1024.0, Stats.InBytesPerSecond / 1024.0);
+		++NumLogged;
+	}
+
+	if (NumLogged == 0)
+	{
+		UE_LOG(LogSlash, Display, TEXT("Net: no connections"));
+	}
+}
+
+void UNetBandwidthSubsystem::WriteReport() const
+{
+	if (Connections.Num() == 0) return;
+
+	FFileHelper::SaveStringToFile(Csv, *(ReportPath + TEXT(".csv")));
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+	double TotalOutBytesPerSecond = 0.0;
+	int32 NumPlayers = 0;
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("intervalSeconds"), CVarNetStatsInterval.GetValueOnGameThread());
+	Writer->WriteArrayStart(TEXT("players"));
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionStats>& Pair : Connections)
+	{
+		const FConnectionStats& Stats = Pair.Value;
+		if (Stats.Seconds <= 0.0) continue;
+
+		const double AvgOutBytesPerSecond = Stats.TotalOutBytes / Stats.Seconds;
+		TotalOutBytesPerSecond += AvgOutBytesPerSecond;
+		++NumPlayers;
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Stats.PlayerName);
+		Writer->WriteValue(TEXT("seconds"), Stats.Seconds);
+		Writer->WriteValue(TEXT("avgOutBytesPerSecond"), AvgOutBytesPerSecond);
+		Writer->WriteValue(TEXT("peakOutBytesPerSecond"), Stats.PeakOutBytesPerSecond);
+		Writer->WriteValue(TEXT("avgInBytesPerSecond"), Stats.TotalInBytes / Stats.Seconds);
+		Writer->WriteValue(TEXT("totalOutBytes"), static_cast<int64>(Stats.TotalOutBytes));
+		Writer->WriteValue(TEXT("totalInBytes"), static_cast<int64>(Stats.TotalInBytes));
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteValue(TEXT("avgOutBytesPerSecondPerPlayer"), NumPlayers > 0 ? TotalOutBytesPerSecond / NumPlayers : 0.0);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	FFileHelper::SaveStringToFile(Json, *(ReportPath + TEXT(".json")));
+	UE_LOG(LogSlash, Display, TEXT("Net: %d players, %.2f KB/s out per player, report written to %s.json"),
+		NumPlayers, NumPlayers > 0 ? TotalOutBytesPerSecond / NumPlayers / 1024.0 : 0.0, *ReportPath);
+}
+
+static FAutoConsoleCommandWithWorld NetBandwidthCommand(
+	TEXT("Slash.Net.Bandwidth"),
+	TEXT("Logs the latest upload and download rates of each net connection, one per remote player on a server."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UNetBandwidthSubsystem* NetBandwidth = World ? World->GetSubsystem<UNetBandwidthSubsystem>() : nullptr)
+		{
+			NetBandwidth->LogRates();
+		}
+	}));
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Random/RandomStreamSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Slash.h"
+
+void URandomStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	int32 SessionSeed = static_cast<int32>(FPlatformTime::Cycles());
+	FParse::Value(FCommandLine::Get(), TEXT("SlashSeed="), SessionSeed);
+	SetSeed(SessionSeed);
+}
+
+void URandomStreamSubsystem::SetSeed(int32 NewSeed)
+{
+	Seed = NewSeed;
+	for (int32 Index = 0; Index < static_cast<int32>(ERandomStream::ERS_MAX); ++Index)
+	{
+		Streams[Index].Initialize(static_cast<int32>(HashCombine(GetTypeHash(Seed), GetTypeHash(Index))));
+	}
+
+	UE_LOG(LogSlash, Log, TEXT("Random streams seeded with %d (repeat with -SlashSeed=%d)"), Seed, Seed);
+}
+
+FRandomStream& URandomStreamSubsystem::GetStream(const UObject* WorldContextObject, ERandomStream Stream)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (URandomStreamSubsystem* RandomStreams = World ? World->GetSubsystem<URandomStreamSubsystem>() : nullptr)
+	{
+		return RandomStreams->GetStream(Stream);
+	}
+
+	// Editor previews, CDOs and other callers without a game world still draw a repeatable sequence
+	static FRandomStream FallbackStream = []()
+	{
+		int32 FallbackSeed = 0;
+		FParse::Value(FCommandLine::Get(), TEXT("SlashSeed="), FallbackSeed);
+		UE_LOG(LogSlash, Log, TEXT("Random stream requested outside a game world, using a shared fallback stream seeded with %d"), FallbackSeed);
+		return FRandomStream(FallbackSeed);
+	}();
+	return FallbackStream;
+}
+
+bool URandomStreamSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+static FAutoConsoleCommandWithWorld RandomSeedCommand(
+	TEXT("Slash.Random.Seed"),
+	TEXT("Logs the seed the world's random streams were started from."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const URandomStreamSubsystem* RandomStreams = World ? World->GetSubsystem<URandomStreamSubsystem>() : nullptr)
+		{
+			UE_LOG(LogSlash, Display, TEXT("Random seed %d (repeat with -SlashSeed=%d)"), RandomStreams->GetSeed(), RandomStreams->GetSeed());
+		}
+	}));
@@ -0,0 +1,398 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Replay/InputReplaySubsystem.h"
+#include "Characters/SlashCharacter.h"
+#include "Random/RandomStreamSubsystem.h"
+#include "EnhancedInputComponent.h"
+#include "InputAction.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Slash.h"
+
+bool UInputReplaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FString Filename;
+	return Super::ShouldCreateSubsystem(Outer) &&
+		(FParse::Param(CommandLine, TEXT("SlashRecordInput")) || FParse::Value(CommandLine, TEXT("SlashRecordInput="), Filename) ||
+		FParse::Value(CommandLine, TEXT("SlashReplay="), Filename));
+}
+
+void UInputReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Started before any actor spawns: the player's pawn binds its input in SpawnPlayActor, ahead of BeginPlay,
+	// and the seed must be in place before anything draws from the streams
+	Collection.InitializeDependency<URandomStreamSubsystem>();
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FString Filename;
+	if (FParse::Value(CommandLine, TEXT("SlashReplay="), Filename))
+	{
+		StartReplay(*GetWorld(), Filename);
+	}
+	else
+	{
+		if (!FParse::Value(CommandLine, TEXT("SlashRecordInput="), Filename))
+		{
+			Filename = FPaths::ProjectSavedDir() / TEXT("Replays") / FString::Printf(TEXT("Slash-%s.slashreplay"), *FDateTime::Now().ToString());
+		}
+		StartRecording(*GetWorld(), Filename);
+	}
+}
+
+void UInputReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (bReplaying)
+	{
+		Report.Begin(&InWorld);
+	}
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UInputReplaySubsystem::OnWorldTickStart);
+}
+
+void UInputReplaySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	StopRecording();
+	Replay.Reset();
+	Report.End();
+
+	Super::Deinitialize();
+}
+
+void UInputReplaySubsystem::Tick(float DeltaTime)
+{
+	if (bReplaying)
+	{
+		Report.RecordFrame();
+	}
+}
+
+TStatId UInputReplaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInputReplaySubsystem, STATGROUP_Tickables);
+}
+
+bool UInputReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInputReplaySubsystem::RecordActions(UEnhancedInputComponent* InputComponent, TArrayView<UInputAction* const> InActions)
+{
+	if (!Recording.IsValid() || InputComponent == nullptr) return;
+
+	for (UInputAction* Action : InActions)
+	{
+		if (Action == nullptr || Actions.Contains(Action)) continue;
+
+		uint8 Tag = static_cast<uint8>(EReplayRecord::ERR_Action);
+		uint8 Index = static_cast<uint8>(Actions.Add(Action));
+		FString Path = Action->GetPathName();
+		*Recording << Tag << Index << Path;
+
+		InputComponent->BindAction(Action, ETriggerEvent::Triggered, this, &UInputReplaySubsystem::OnActionTriggered);
+	}
+}
+
+void UInputReplaySubsystem::StartRecording(UWorld& InWorld, const FString& Filename)
+{
+	Recording.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Recording.IsValid())
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Replay: could not open %s for recording"), *Filename);
+		return;
+	}
+
+	const URandomStreamSubsystem* RandomStreams = InWorld.GetSubsystem<URandomStreamSubsystem>();
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Seed = RandomStreams ? RandomStreams->GetSeed() : 0;
+	NumRecordedInputs = 0;
+	FString MapName = UWorld::RemovePIEPrefix(InWorld.GetMapName());
+	*Recording << Magic << Version << Seed << MapName;
+
+	UE_LOG(LogSlash, Display, TEXT("Replay: recording %s with seed %d"), *Filename, Seed);
+}
+
+void UInputReplaySubsystem::StopRecording()
+{
+	if (!Recording.IsValid()) return;
+
+	uint8 Tag = static_cast<uint8>(EReplayRecord::ERR_End);
+	*Recording << Tag;
+	Recording->Close();
+	Recording.Reset();
+
+	// Bound actions alone replay nothing, the inputs are what counts
+	if (NumRecordedInputs == 0)
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Replay: recorded %u frames but no inputs, %d input actions were bound"), Frame, Actions.Num());
+		return;
+	}
+	UE_LOG(LogSlash, Display, TEXT("Replay: recorded %u frames and %u inputs of %d input actions"), Frame, NumRecordedInputs, Actions.Num());
+}
+
+void UInputReplaySubsystem::OnActionTriggered(const FInputActionInstance& Instance)
+{
+	if (!Recording.IsValid()) return;
+
+	const int32 Index = Actions.IndexOfByKey(Instance.GetSourceAction());
+	if (Index == INDEX_NONE) return;
+
+	const FInputActionValue Value = Instance.GetValue();
+	uint8 Tag = static_cast<uint8>(EReplayRecord::ERR_Input);
+	uint8 ActionIndex = static_cast<uint8>(Index);
+	uint8 ValueType = static_cast<uint8>(Value.GetValueType());
+	*Recording << Tag << ActionIndex << ValueType;
+
+	// Booleans and 1D axes store a single component
+	FVector3f Axis(Value.Get<FVector>());
+	for (int32 Component = 0; Component < FMath::Max<int32>(ValueType, 1); ++Component)
+	{
+		*Recording << Axis[Component];
+	}
+	++NumRecordedInputs;
+}
+
+void UInputReplaySubsystem::StartReplay(UWorld& InWorld, const FString& Filename)
+{
+	ReplayFilename = Filename;
+	Replay.Reset(IFileManager::Get().CreateFileReader(*Filename));
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FString MapName;
+	if (Replay.IsValid())
+	{
+		*Replay << Magic << Version << Seed << MapName;
+	}
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogSlash, Error, TEXT("Replay: %s is not a version %u replay"), *Filename, FileVersion);
+		Replay.Reset();
+		return;
+	}
+
+	if (MapName != UWorld::RemovePIEPrefix(InWorld.GetMapName()))
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Replay: %s was recorded on %s"), *Filename, *MapName);
+	}
+
+	// Scans ahead to the first input record. The first frame's delta time is set here, before the engine steps that frame
+	const int64 FirstRecord = Replay->Tell();
+	bool bFirstFrame = true;
+	bool bHasInput = false;
+	bool bScanning = true;
+	while (bScanning && !Replay->AtEnd())
+	{
+		uint8 Tag = 0;
+		*Replay << Tag;
+
+		switch (static_cast<EReplayRecord>(Tag))
+		{
+		case EReplayRecord::ERR_Frame:
+		{
+			float DeltaSeconds = 0.f;
+			*Replay << DeltaSeconds;
+			if (bFirstFrame)
+			{
+				FApp::SetFixedDeltaTime(DeltaSeconds);
+				bFirstFrame = false;
+			}
+			break;
+		}
+		case EReplayRecord::ERR_Action:
+		{
+			uint8 Index = 0;
+			FString Path;
+			*Replay << Index << Path;
+			break;
+		}
+		case EReplayRecord::ERR_Checkpoint:
+		{
+			FVector3f RecordedLocation;
+			*Replay << RecordedLocation;
+			break;
+		}
+		case EReplayRecord::ERR_Input:
+			bHasInput = true;
+			bScanning = false;
+			break;
+		default:
+			bScanning = false;
+			break;
+		}
+	}
+	Replay->Seek(FirstRecord);
+
+	if (!bHasInput)
+	{
+		UE_LOG(LogSlash, Error, TEXT("Replay: %s holds no inputs, nothing would be replayed"), *Filename);
+		Replay.Reset();
+		return;
+	}
+
+	if (URandomStreamSubsystem* RandomStreams = InWorld.GetSubsystem<URandomStreamSubsystem>())
+	{
+		RandomStreams->SetSeed(Seed);
+	}
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("Replay-%s"), *FDateTime::Now().ToString());
+	FParse::Value(CommandLine, TEXT("ReplayReport="), ReportPath);
+	bExitWhenDone = !FParse::Param(CommandLine, TEXT("ReplayNoExit"));
+
+	// Frames are stepped with the recorded delta times, set ahead of each frame by ReplayFrame
+	FApp::SetUseFixedTimeStep(true);
+	bReplaying = true;
+
+	UE_LOG(LogSlash, Display, TEXT("Replay: playing %s with seed %d"), *Filename, Seed);
+}
+
+void UInputReplaySubsystem::ReplayFrame()
+{
+	ASlashCharacter* Character = nullptr;
+	if (const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		Character = Cast<ASlashCharacter>(PlayerController->GetPawn());
+	}
+
+	bool bFrameStarted = false;
+	while (!Replay->AtEnd())
+	{
+		const int64 RecordStart = Replay->Tell();
+		uint8 Tag = 0;
+		*Replay << Tag;
+
+		switch (static_cast<EReplayRecord>(Tag))
+		{
+		case EReplayRecord::ERR_Frame:
+		{
+			float DeltaSeconds = 0.f;
+			*Replay << DeltaSeconds;
+			FApp::SetFixedDeltaTime(DeltaSeconds);
+			if (bFrameStarted)
+			{
+				// Next frame's record, leave it for the next tick
+				Replay->Seek(RecordStart);
+				++Frame;
+				return;
+			}
+			bFrameStarted = true;
+			break;
+		}
+		case EReplayRecord::ERR_Action:
+		{
+			uint8 Index = 0;
+			FString Path;
+			*Replay << Index << Path;
+			Actions.SetNumZeroed(FMath::Max<int32>(Actions.Num(), Index + 1));
+			Actions[Index] = LoadObject<UInputAction>(nullptr, *Path);
+			break;
+		}
+		case EReplayRecord::ERR_Input:
+		{
+			uint8 ActionIndex = 0;
+			uint8 ValueType = 0;
+			*Replay << ActionIndex << ValueType;
+
+			FVector3f Axis = FVector3f::ZeroVector;
+			for (int32 Component = 0; Component < FMath::Max<int32>(ValueType, 1); ++Component)
+			{
+				*Replay << Axis[Component];
+			}
+
+			if (Character && Actions.IsValidIndex(ActionIndex))
+			{
+				Character->ReplayInput(Actions[ActionIndex], FInputActionValue(static_cast<EInputActionValueType>(ValueType), FVector(Axis)));
+			}
+			break;
+		}
+		case EReplayRecord::ERR_Checkpoint:
+		{
+			FVector3f RecordedLocation;
+			*Replay << RecordedLocation;
+
+			FVector Location;
+			if (GetPlayerLocation(Location) && FVector::Dist(Location, FVector(RecordedLocation)) > CheckpointTolerance && NumDivergedCheckpoints++ == 0)
+			{
+				UE_LOG(LogSlash, Warning, TEXT("Replay: diverged at frame %u, player is %.1f from the recorded location"), Frame, FVector::Dist(Location, FVector(RecordedLocation)));
+			}
+			break;
+		}
+		default:
+			FinishReplay();
+			return;
+		}
+	}
+
+	FinishReplay();
+}
+
+void UInputReplaySubsystem::FinishReplay()
+{
+	bReplaying = false;
+	Replay.Reset();
+	Report.End();
+	FApp::SetUseFixedTimeStep(false);
+
+	Report.Write(ReportPath, [this](TJsonWriter<>& Writer)
+	{
+		Writer.WriteValue(TEXT("replay"), ReplayFilename);
+		Writer.WriteValue(TEXT("seed"), Seed);
+		Writer.WriteValue(TEXT("commandLine"), FCommandLine::Get());
+		Writer.WriteValue(TEXT("replayedFrames"), static_cast<int64>(Frame));
+		Writer.WriteValue(TEXT("divergedCheckpoints"), static_cast<int64>(NumDivergedCheckpoints));
+	});
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UInputReplaySubsystem::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+
+	if (Recording.IsValid())
+	{
+		uint8 Tag = static_cast<uint8>(EReplayRecord::ERR_Frame);
+		*Recording << Tag << DeltaSeconds;
+
+		FVector Location;
+		if (Frame % CheckpointInterval == 0 && GetPlayerLocation(Location))
+		{
+			Tag = static_cast<uint8>(EReplayRecord::ERR_Checkpoint);
+			FVector3f Checkpoint(Location);
+			*Recording << Tag << Checkpoint;
+		}
+		++Frame;
+	}
+	else if (bReplaying && Replay.IsValid())
+	{
+		ReplayFrame();
+	}
+}
+
+bool UInputReplaySubsystem::GetPlayerLocation(FVector& OutLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (Pawn == nullptr) return false;
+
+	OutLocation = Pawn->GetActorLocation();
+	return true;
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Spatial/PawnSpatialGridSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Slash/SlashStats.h"
+#include "Slash.h"
+
+void UPawnSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashPawnGrid);
+	for (int32 Handle = 0; Handle < HandleToPawn.Num(); ++Handle)
+	{
+		const APawn* Pawn = HandleToPawn[Handle];
+		if (Pawn && Grid.IsValidHandle(Handle))
+		{
+			Grid.Update(Handle, Pawn->GetActorLocation());
+		}
+	}
+}
+
+TStatId UPawnSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPawnSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+void UPawnSpatialGridSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (Pawn == nullptr || PawnToHandle.Contains(Pawn)) return;
+
+	const int32 Handle = Grid.Add(Pawn->GetActorLocation());
+	if (Handle >= HandleToPawn.Num())
+	{
+		HandleToPawn.SetNumZeroed(Handle + 1);
+	}
+	HandleToPawn[Handle] = Pawn;
+	PawnToHandle.Add(Pawn, Handle);
+}
+
+void UPawnSpatialGridSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	int32 Handle = INDEX_NONE;
+	if (PawnToHandle.RemoveAndCopyValue(Pawn, Handle))
+	{
+		Grid.Remove(Handle);
+		HandleToPawn[Handle] = nullptr;
+	}
+}
+
+void UPawnSpatialGridSubsystem::QueryPawnsInRadius(const FVector& Center, double Radius, TArray<APawn*>& OutPawns) const
+{
+	QueryHandles.Reset();
+	Grid.QueryRadius(Center, Radius, QueryHandles);
+	GatherPawns(OutPawns);
+}
+
+void UPawnSpatialGridSubsystem::QueryPawnsInCone(const FVector& Origin, const FVector& Direction, double Radius, float HalfAngleDegrees, TArray<APawn*>& OutPawns) const
+{
+	QueryHandles.Reset();
+	Grid.QueryCone(Origin, Direction, Radius, HalfAngleDegrees, QueryHandles);
+	GatherPawns(OutPawns);
+}
+
+bool UPawnSpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPawnSpatialGridSubsystem::GatherPawns(TArray<APawn*>& OutPawns) const
+{
+	for (const int32 Handle : QueryHandles)
+	{
+		if (APawn* Pawn = HandleToPawn[Handle])
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+/**
+ * Compares the grid against what UPawnSensingComponent does per sensor (iterate every pawn, distance and
+ * peripheral angle test) with every pawn acting as a sensor. Line of sight traces are excluded from both.
+ */
+static void RunSpatialGridBenchmark(const TArray<FString>& Args)
+{
+	const double SightRadius = Args.Num() > 0 ? FCString::Atod(*Args[0]) : 1000.0;
+	const float PeripheralVisionAngle = 45.f;
+	const double WorldHalfExtent = 20000.0;
+	const int32 PawnCounts[] = { 100, 1000, 5000 };
+
+	for (const int32 NumPawns : PawnCounts)
+	{
+		FRandomStream Stream(NumPawns);
+		TArray<FVector> Locations;
+		TArray<FVector> Forwards;
+		for (int32 Index = 0; Index < NumPawns; ++Index)
+		{
+			Locations.Add(FVector(Stream.FRandRange(-WorldHalfExtent, WorldHalfExtent), Stream.FRandRange(-WorldHalfExtent, WorldHalfExtent), 0.0));
+			Forwards.Add(FRotator(0.0, Stream.FRandRange(0.0, 360.0), 0.0).Vector());
+		}
+
+		const double RadiusSquared = FMath::Square(SightRadius);
+		const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(PeripheralVisionAngle));
+
+		int32 BruteForceHits = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Sensor = 0; Sensor < NumPawns; ++Sensor)
+		{
+			for (int32 Other = 0; Other < NumPawns; ++Other)
+			{
+				if (Other == Sensor) continue;
+
+				const FVector ToOther = Locations[Other] - Locations[Sensor];
+				const double DistanceSquared = ToOther.SizeSquared();
+				if (DistanceSquared <= RadiusSquared && FVector::DotProduct(Forwards[Sensor], ToOther) >= CosHalfAngle * FMath::Sqrt(DistanceSquared))
+				{
+					++BruteForceHits;
+				}
+			}
+		}
+		const double BruteForceMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		FSpatialHashGrid Grid(SightRadius);
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Location : Locations)
+		{
+			Grid.Add(Location);
+		}
+		const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Handle = 0; Handle < NumPawns; ++Handle)
+		{
+			Grid.Update(Handle, Locations[Handle] + Forwards[Handle] * 10.0);
+		}
+		const double UpdateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		for (int32 Handle = 0; Handle < NumPawns; ++Handle)
+		{
+			Grid.Update(Handle, Locations[Handle]);
+		}
+
+		int32 GridHits = 0;
+		TArray<int32> Handles;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Sensor = 0; Sensor < NumPawns; ++Sensor)
+		{
+			Handles.Reset();
+			Grid.QueryCone(Locations[Sensor], Forwards[Sensor], SightRadius, PeripheralVisionAngle, Handles);
+			GridHits += Handles.Num() - (Handles.Contains(Sensor) ? 1 : 0);
+		}
+		const double GridMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogSlash, Display, TEXT("SpatialGrid %5d pawns: sensing path %8.3f ms (%6.2f us/query) | grid %8.3f ms (%6.2f us/query), build %.3f ms, update %.3f ms | hits %d/%d"),
+			NumPawns,
+			BruteForceMs, BruteForceMs * 1000.0 / NumPawns,
+			GridMs, GridMs * 1000.0 / NumPawns,
+			BuildMs, UpdateMs,
+			GridHits, BruteForceHits);
+	}
+}
+
+static FAutoConsoleCommand SpatialGridBenchmarkCommand(
+	TEXT("Slash.Bench.SpatialGrid"),
+	TEXT("Benchmarks pawn sight queries at 100, 1k and 5k pawns, brute force vs spatial grid. Optional arg: sight radius."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunSpatialGridBenchmark));
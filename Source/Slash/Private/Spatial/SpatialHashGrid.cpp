@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Spatial/SpatialHashGrid.h"
+
+FSpatialHashGrid::FSpatialHashGrid(double InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0))
+	, InvCellSize(1.0 / CellSize)
+{
+}
+
+int32 FSpatialHashGrid::Add(const FVector& Location)
+{
+	const int32 Handle = Elements.Add({ Location, GetCell(Location), INDEX_NONE });
+	AddToCell(Handle, Elements[Handle].Cell);
+	return Handle;
+}
+
+void FSpatialHashGrid::Remove(int32 Handle)
+{
+	if (!Elements.IsValidIndex(Handle)) return;
+
+	RemoveFromCell(Handle);
+	Elements.RemoveAt(Handle);
+}
+
+void FSpatialHashGrid::Update(int32 Handle, const FVector& Location)
+{
+	FElement& Element = Elements[Handle];
+	Element.Location = Location;
+
+	const FIntPoint NewCell = GetCell(Location);
+	if (NewCell != Element.Cell)
+	{
+		RemoveFromCell(Handle);
+		AddToCell(Handle, NewCell);
+	}
+}
+
+void FSpatialHashGrid::Reset()
+{
+	Elements.Reset();
+	Cells.Reset();
+}
+
+void FSpatialHashGrid::QueryRadius(const FVector& Center, double Radius, TArray<int32>& OutHandles) const
+{
+	const double RadiusSquared = FMath::Square(Radius);
+	GatherInRadius(Center, Radius, OutHandles, [&](const FElement& Element)
+	{
+		return FVector::DistSquared(Element.Location, Center) <= RadiusSquared;
+	});
+}
+
+void FSpatialHashGrid::QueryCone(const FVector& Origin, const FVector& Direction, double Radius, float HalfAngleDegrees, TArray<int32>& OutHandles) const
+{
+	const double RadiusSquared = FMath::Square(Radius);
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+	GatherInRadius(Origin, Radius, OutHandles, [&](const FElement& Element)
+	{
+		const FVector ToElement = Element.Location - Origin;
+		const double DistanceSquared = ToElement.SizeSquared();
+		if (DistanceSquared > RadiusSquared) return false;
+
+		// Dot(Direction, ToElement) >= Cos * |ToElement|, squared to avoid the sqrt
+		const double Dot = FVector::DotProduct(Direction, ToElement);
+		const double ConeSquared = FMath::Square(CosHalfAngle) * DistanceSquared;
+		if (CosHalfAngle >= 0.0)
+		{
+			return Dot >= 0.0 && FMath::Square(Dot) >= ConeSquared;
+		}
+		return Dot >= 0.0 || FMath::Square(Dot) <= ConeSquared;
+	});
+}
+
+FIntPoint FSpatialHashGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+}
+
+void FSpatialHashGrid::AddToCell(int32 Handle, const FIntPoint& Cell)
+{
+	TArray<int32>& CellHandles = Cells.FindOrAdd(Cell);
+	Elements[Handle].Cell = Cell;
+	Elements[Handle].IndexInCell = CellHandles.Add(Handle);
+}
+
+void FSpatialHashGrid::RemoveFromCell(int32 Handle)
+{
+	const FElement& Element = Elements[Handle];
+	TArray<int32>& CellHandles = Cells.FindChecked(Element.Cell);
+
+	CellHandles.RemoveAtSwap(Element.IndexInCell, 1, false);
+	if (CellHandles.IsValidIndex(Element.IndexInCell))
+	{
+		Elements[CellHandles[Element.IndexInCell]].IndexInCell = Element.IndexInCell;
+	}
+}
+
+template<typename PredicateType>
+void FSpatialHashGrid::GatherInRadius(const FVector& Center, double Radius, TArray<int32>& OutHandles, PredicateType Predicate) const
+{
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* CellHandles = Cells.Find(FIntPoint(X, Y));
+			if (CellHandles == nullptr) continue;
+
+			for (const int32 Handle : *CellHandles)
+			{
+				if (Predicate(Elements[Handle]))
+				{
+					OutHandles.Add(Handle);
+				}
+			}
+		}
+	}
+}
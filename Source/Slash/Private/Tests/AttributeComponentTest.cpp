@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AttributeComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Net/UnrealNetwork.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributeReplicatedPropsTest, "Slash.Attributes.ReplicatedProps",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAttributeReplicatedPropsTest::RunTest(const FString& Parameters)
+{
+	TArray<FLifetimeProperty> LifetimeProps;
+	GetDefault<UAttributeComponent>()->GetLifetimeReplicatedProps(LifetimeProps);
+
+	// The values and the effective max the server evaluates from its modifiers
+	for (const TCHAR* PropertyName : { TEXT("Values"), TEXT("Maxes") })
+	{
+		const FProperty* Property = FindFProperty<FProperty>(UAttributeComponent::StaticClass(), PropertyName);
+		if (!TestNotNull(FString::Printf(TEXT("%s property"), PropertyName), Property)) continue;
+
+		TestEqual(FString::Printf(TEXT("%s array size"), PropertyName), Property->ArrayDim, UAttributeComponent::NumAttributes);
+		TestEqual(FString::Printf(TEXT("%s rep notify"), PropertyName), Property->RepNotifyFunc, FName(FString::Printf(TEXT("OnRep_%s"), PropertyName)));
+
+		// Each element is registered on its own and push based, or unchanged attributes would be compared every update
+		for (int32 Index = 0; Index < UAttributeComponent::NumAttributes; ++Index)
+		{
+			const uint16 RepIndex = Property->RepIndex + Index;
+			const FLifetimeProperty* LifetimeProp = LifetimeProps.FindByPredicate([RepIndex](const FLifetimeProperty& Prop) { return Prop.RepIndex == RepIndex; });
+			if (!TestNotNull(FString::Printf(TEXT("%s[%d] replicated"), PropertyName, Index), LifetimeProp)) continue;
+
+			TestTrue(FString::Printf(TEXT("%s[%d] push based"), PropertyName, Index), LifetimeProp->bIsPushBased);
+			TestTrue(FString::Printf(TEXT("%s[%d] sent to everyone"), PropertyName, Index), LifetimeProp->Condition == COND_None);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAttributeDirtyTest, "Slash.Attributes.MarkedDirtyOnChange",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAttributeDirtyTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	AActor* Owner = World->SpawnActor<AActor>();
+	UAttributeComponent* Attributes = NewObject<UAttributeComponent>(Owner);
+	Attributes->RegisterComponent();
+
+	// The component only ticks to broadcast elements marked dirty, and every mark also dirties the element for push model
+	int32 NumBroadcasts = 0;
+	Attributes->OnStaminaChanged.AddLambda([&NumBroadcasts](float) { ++NumBroadcasts; });
+	auto IsMarkedDirty = [Attributes]()
+	{
+		const bool bDirty = Attributes->IsComponentTickEnabled();
+		Attributes->TickComponent(0.f, LEVELTICK_All, nullptr);
+		return bDirty;
+	};
+	IsMarkedDirty();
+
+	const float Stamina = Attributes->GetStamina();
+	Attributes->SetValue(EAttributeId::EAI_Stamina, Stamina);
+	TestFalse(TEXT("Unchanged value marked dirty"), IsMarkedDirty());
+
+	Attributes->UseStamina(10.f);
+	TestEqual(TEXT("Stamina after use"), Attributes->GetStamina(), Stamina - 10.f);
+	TestTrue(TEXT("Changed value marked dirty"), IsMarkedDirty());
+
+	Attributes->SetValue(EAttributeId::EAI_Stamina, Attributes->GetMax(EAttributeId::EAI_Stamina) + 50.f);
+	TestEqual(TEXT("Stamina clamped to its max"), Attributes->GetStamina(), Attributes->GetMax(EAttributeId::EAI_Stamina));
+	TestTrue(TEXT("Clamped value marked dirty"), IsMarkedDirty());
+
+	// Regen batches its marks until the regen subsystem flushes them
+	Attributes->UseStamina(10.f);
+	IsMarkedDirty();
+	NumBroadcasts = 0;
+	const float BeforeRegen = Attributes->GetStamina();
+	Attributes->ApplyRegen(1.f);
+	TestTrue(TEXT("Stamina regenerated"), Attributes->GetStamina() > BeforeRegen);
+	TestFalse(TEXT("Regen marked dirty before its flush"), Attributes->IsComponentTickEnabled());
+	Attributes->FlushRegenChanges();
+	TestTrue(TEXT("Regen marked dirty on flush"), IsMarkedDirty());
+	TestEqual(TEXT("Broadcasts after regen"), NumBroadcasts, 1);
+
+	// Modifiers stay on the server, the max they produce is what clients read
+	const FProperty* MaxesProperty = FindFProperty<FProperty>(UAttributeComponent::StaticClass(), TEXT("Maxes"));
+	const float* Maxes = MaxesProperty->ContainerPtrToValuePtr<float>(Attributes);
+	const int32 StaminaIndex = static_cast<int32>(EAttributeId::EAI_Stamina);
+	const float BaseMax = Attributes->GetMax(EAttributeId::EAI_Stamina);
+	TestEqual(TEXT("Replicated max starts at the definition"), Maxes[StaminaIndex], BaseMax);
+	const int32 Handle = Attributes->AddModifier(EAttributeId::EAI_Stamina, EAttributeModifierTarget::EAMT_Max, EAttributeModifierOp::EAMO_Add, 50.f);
+	TestEqual(TEXT("Replicated max follows a modifier"), Maxes[StaminaIndex], BaseMax + 50.f);
+	Attributes->RemoveModifier(Handle);
+	TestEqual(TEXT("Replicated max after the modifier is removed"), Maxes[StaminaIndex], BaseMax);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
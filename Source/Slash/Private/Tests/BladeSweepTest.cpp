@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/BladeSweep.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr double SwingDuration = 0.3;
+	constexpr double RecordingRate = 1000.0;
+	constexpr double MaxStepDistance = 10.0;
+	constexpr double BoxHalfExtent = 5.0;
+	constexpr double TargetRadius = 8.0;
+
+	const FVector Shoulder(0.0, 0.0, 150.0);
+	const FVector HandOffset(40.0, 0.0, 0.0);
+	const FVector BladeStart(10.0, 0.0, 0.0);
+	const FVector BladeEnd(110.0, 0.0, 0.0);
+
+	/** The hand socket of a right to left slash turning about the shoulder, eased in and out like an attack montage */
+	FTransform GetSocketAt(double Time)
+	{
+		const double Alpha = FMath::SmoothStep(0.0, 1.0, FMath::Clamp(Time / SwingDuration, 0.0, 1.0));
+		const FQuat Rotation = FRotator(-15.0, FMath::Lerp(-100.0, 80.0, Alpha), 0.0).Quaternion();
+		return FTransform(Rotation, Shoulder + Rotation.RotateVector(HandOffset));
+	}
+
+	TArray<FTransform> RecordSwing()
+	{
+		TArray<FTransform> Keys;
+		const int32 NumKeys = FMath::CeilToInt32(SwingDuration * RecordingRate) + 1;
+		for (int32 Key = 0; Key < NumKeys; ++Key)
+		{
+			Keys.Add(GetSocketAt(Key / RecordingRate));
+		}
+		return Keys;
+	}
+
+	TArray<FSphere> MakeTargets()
+	{
+		TArray<FSphere> Targets;
+		for (const double Fraction : { 0.1, 0.35, 0.6, 0.9 })
+		{
+			const FTransform Socket = GetSocketAt(Fraction * SwingDuration);
+			const FVector BladeMiddle = Socket.TransformPosition(0.5 * (BladeStart + BladeEnd));
+			const FVector BladeDirection = Socket.TransformVector(BladeEnd - BladeStart).GetSafeNormal();
+
+			// Indices 4n are on the blade's path, the rest are near misses above it, past its tip and around it
+			Targets.Add(FSphere(BladeMiddle, TargetRadius));
+			Targets.Add(FSphere(BladeMiddle + FVector(0.0, 0.0, 40.0), TargetRadius));
+			Targets.Add(FSphere(Socket.TransformPosition(BladeEnd) + BladeDirection * 30.0, TargetRadius));
+			Targets.Add(FSphere(Socket.TransformPosition(BladeStart) - FVector(0.0, 0.0, 35.0), TargetRadius));
+		}
+
+		// Just outside either end of the swing
+		Targets.Add(FSphere(FTransform(FRotator(-15.0, -125.0, 0.0), Shoulder).TransformPosition(HandOffset + 0.5 * (BladeStart + BladeEnd)), TargetRadius));
+		Targets.Add(FSphere(FTransform(FRotator(-15.0, 105.0, 0.0), Shoulder).TransformPosition(HandOffset + 0.5 * (BladeStart + BladeEnd)), TargetRadius));
+		return Targets;
+	}
+
+	/** Plays the recording back like AWeapon::SweepBlade at FramesPerSecond, returns the targets the blade touched */
+	TArray<int32> ReplaySwing(const TArray<FTransform>& Keys, const TArray<FSphere>& Targets, double FramesPerSecond, double& OutMaxStep)
+	{
+		FBladeSweep Sweep;
+		Sweep.LocalStart = FTransform(BladeStart);
+		Sweep.LocalEnd = BladeEnd;
+
+		TArray<int32> Hits;
+		auto TracePose = [&Hits, &Targets](const FVector& Start, const FVector& End)
+		{
+			for (int32 Index = 0; Index < Targets.Num(); ++Index)
+			{
+				if (!Hits.Contains(Index) && FMath::PointDistToSegment(Targets[Index].Center, Start, End) <= Targets[Index].W + BoxHalfExtent)
+				{
+					Hits.Add(Index);
+				}
+			}
+		};
+
+		FTransform Previous = Keys[0];
+		TracePose(Previous.TransformPosition(BladeStart), Previous.TransformPosition(BladeEnd));
+		FVector PreviousEnd = Previous.TransformPosition(BladeEnd);
+		OutMaxStep = 0.0;
+
+		for (int32 Frame = 1; ; ++Frame)
+		{
+			const int32 Key = FMath::Min(FMath::RoundToInt32(Frame / FramesPerSecond * RecordingRate), Keys.Num() - 1);
+			Sweep.SetFrame(Previous, Keys[Key]);
+
+			const int32 NumSubsteps = Sweep.GetNumSubsteps(MaxStepDistance);
+			for (int32 Substep = 1; Substep <= NumSubsteps; ++Substep)
+			{
+				FVector Start;
+				FVector End;
+				FQuat Rotation;
+				Sweep.GetPose(static_cast<double>(Substep) / NumSubsteps, Start, End, Rotation);
+				TracePose(Start, End);
+
+				OutMaxStep = FMath::Max(OutMaxStep, FVector::Dist(End, PreviousEnd));
+				PreviousEnd = End;
+			}
+
+			Previous = Keys[Key];
+			if (Key == Keys.Num() - 1) break;
+		}
+
+		Hits.Sort();
+		return Hits;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBladeSweepFrameRateTest, "Slash.Combat.BladeSweep.FrameRateIndependent",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBladeSweepFrameRateTest::RunTest(const FString& Parameters)
+{
+	const TArray<FTransform> Keys = RecordSwing();
+	const TArray<FSphere> Targets = MakeTargets();
+	const TArray<int32> Expected = { 0, 4, 8, 12 };
+
+	for (const double FramesPerSecond : { 30.0, 60.0, 144.0 })
+	{
+		double MaxStep = 0.0;
+		const TArray<int32> Hits = ReplaySwing(Keys, Targets, FramesPerSecond, MaxStep);
+
+		const FString HitList = FString::JoinBy(Hits, TEXT(","), [](int32 Index) { return FString::FromInt(Index); });
+		TestTrue(FString::Printf(TEXT("Hit set at %.0f fps {%s}"), FramesPerSecond, *HitList), Hits == Expected);
+		TestTrue(FString::Printf(TEXT("Blade tip step at %.0f fps (%.2f) within the sub-step distance"), FramesPerSecond, MaxStep),
+			MaxStep <= MaxStepDistance + UE_KINDA_SMALL_NUMBER);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBladeSweepArcTest, "Slash.Combat.BladeSweep.FollowsArc",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FBladeSweepArcTest::RunTest(const FString& Parameters)
+{
+	// A single 90 degree frame about the shoulder, the poses must stay on the shoulder's sphere
+	FBladeSweep Sweep;
+	Sweep.LocalStart = FTransform(BladeStart);
+	Sweep.LocalEnd = BladeEnd;
+
+	const FTransform From = GetSocketAt(0.0);
+	const FTransform To(FRotator(-15.0, -10.0, 0.0), Shoulder + FRotator(-15.0, -10.0, 0.0).RotateVector(HandOffset));
+	Sweep.SetFrame(From, To);
+
+	const double TipRadius = FVector::Dist(From.TransformPosition(BladeEnd), Shoulder);
+	for (const double Alpha : { 0.0, 0.25, 0.5, 0.75, 1.0 })
+	{
+		FVector Start;
+		FVector End;
+		FQuat Rotation;
+		Sweep.GetPose(Alpha, Start, End, Rotation);
+		TestEqual(FString::Printf(TEXT("Tip distance from the shoulder at alpha %.2f"), Alpha), FVector::Dist(End, Shoulder), TipRadius, 1.0e-3);
+	}
+
+	FVector Start;
+	FVector End;
+	FQuat Rotation;
+	Sweep.GetPose(1.0, Start, End, Rotation);
+	TestEqual(TEXT("Last pose start"), Start, To.TransformPosition(BladeStart), 1.0e-3);
+	TestEqual(TEXT("Last pose end"), End, To.TransformPosition(BladeEnd), 1.0e-3);
+	TestTrue(TEXT("Last pose rotation"), Rotation.Equals(To.GetRotation(), 1.0e-4));
+
+	return true;
+}
+
+#endif
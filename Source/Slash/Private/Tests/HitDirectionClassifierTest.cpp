@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/HitDirectionClassifier.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Away from the edges by far more than ClassifyByAngle's rounding */
+	constexpr double EdgeOffset = 0.01;
+
+	const TCHAR* DirectionName(EHitReactDirection Direction)
+	{
+		switch (Direction)
+		{
+		case EHitReactDirection::EHR_FromFront: return TEXT("front");
+		case EHitReactDirection::EHR_FromBack: return TEXT("back");
+		case EHitReactDirection::EHR_FromLeft: return TEXT("left");
+		case EHitReactDirection::EHR_FromRight: return TEXT("right");
+		default: return TEXT("none");
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitDirectionEdgesTest, "Slash.Combat.HitDirection.Edges",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHitDirectionEdgesTest::RunTest(const FString& Parameters)
+{
+	// Exactly on the edges, the squares are exact so the ties go where the angle thresholds put them
+	const FVector Location(100.0, -200.0, 50.0);
+	const FVector Forward = FVector::ForwardVector;
+	TestEqual(TEXT("+45 is right"), FHitDirectionClassifier::Classify(Forward, Location, Location + FVector(100.0, 100.0, 0.0)), EHitReactDirection::EHR_FromRight);
+	TestEqual(TEXT("-45 is front"), FHitDirectionClassifier::Classify(Forward, Location, Location + FVector(100.0, -100.0, 0.0)), EHitReactDirection::EHR_FromFront);
+	TestEqual(TEXT("+135 is back"), FHitDirectionClassifier::Classify(Forward, Location, Location + FVector(-100.0, 100.0, 0.0)), EHitReactDirection::EHR_FromBack);
+	TestEqual(TEXT("-135 is left"), FHitDirectionClassifier::Classify(Forward, Location, Location + FVector(-100.0, -100.0, 0.0)), EHitReactDirection::EHR_FromLeft);
+
+	// Either side of each edge, for victims facing any way
+	for (const double Yaw : { 0.0, 17.0, 90.0, 163.5, -120.0, 271.0 })
+	{
+		const FVector YawForward = FRotator(0.0, Yaw, 0.0).Vector();
+		for (const double Edge : { 45.0, -45.0, 135.0, -135.0 })
+		{
+			for (const double Offset : { -EdgeOffset, EdgeOffset })
+			{
+				const FVector HitFrom = Location + FRotator(0.0, Yaw + Edge + Offset, 0.0).Vector() * 250.0 + FVector(0.0, 0.0, 80.0);
+				const EHitReactDirection ByAngle = FHitDirectionClassifier::ClassifyByAngle(YawForward, Location, HitFrom);
+				const EHitReactDirection Classified = FHitDirectionClassifier::Classify(YawForward, Location, HitFrom);
+				TestEqual(FString::Printf(TEXT("Yaw %.1f, hit at %.2f: %s by angle, %s by signs"), Yaw, Edge + Offset, DirectionName(ByAngle), DirectionName(Classified)),
+					Classified, ByAngle);
+			}
+		}
+	}
+
+	// No horizontal distance has no direction, both paths fall back to 90 degrees
+	for (const FVector& HitFrom : { Location, Location + FVector(0.0, 0.0, 120.0) })
+	{
+		TestEqual(TEXT("Zero distance by angle"), FHitDirectionClassifier::ClassifyByAngle(Forward, Location, HitFrom), EHitReactDirection::EHR_FromRight);
+		TestEqual(TEXT("Zero distance by signs"), FHitDirectionClassifier::Classify(Forward, Location, HitFrom), EHitReactDirection::EHR_FromRight);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitDirectionBatchTest, "Slash.Combat.HitDirection.BatchMatchesAngles",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHitDirectionBatchTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(1234);
+	TArray<FVector> Forwards;
+	TArray<FVector> Locations;
+	TArray<FVector> HitFroms;
+	for (int32 Index = 0; Index < 512; ++Index)
+	{
+		const double Yaw = Stream.FRandRange(0.0, 360.0);
+		const FVector Location(Stream.FRandRange(-5000.0, 5000.0), Stream.FRandRange(-5000.0, 5000.0), Stream.FRandRange(0.0, 500.0));
+
+		// Every eighth hit is just either side of an edge, every 64th has no horizontal distance
+		double HitYaw = Stream.FRandRange(0.0, 360.0);
+		if (Index % 8 == 0)
+		{
+			HitYaw = Yaw + 45.0 + 90.0 * Stream.RandRange(0, 3) + (Stream.RandRange(0, 1) ? EdgeOffset : -EdgeOffset);
+		}
+		const double HitDistance = Index % 64 == 0 ? 0.0 : Stream.FRandRange(10.0, 500.0);
+
+		Forwards.Add(FRotator(0.0, Yaw, 0.0).Vector());
+		Locations.Add(Location);
+		HitFroms.Add(Location + FRotator(0.0, HitYaw, 0.0).Vector() * HitDistance + FVector(0.0, 0.0, Stream.FRandRange(-100.0, 100.0)));
+	}
+
+	TArray<EHitReactDirection> Batched;
+	Batched.SetNumUninitialized(HitFroms.Num());
+	FHitDirectionClassifier::ClassifyBatch(Forwards, Locations, HitFroms, Batched);
+
+	int32 Mismatches = 0;
+	for (int32 Index = 0; Index < HitFroms.Num(); ++Index)
+	{
+		const EHitReactDirection ByAngle = FHitDirectionClassifier::ClassifyByAngle(Forwards[Index], Locations[Index], HitFroms[Index]);
+		const EHitReactDirection Single = FHitDirectionClassifier::Classify(Forwards[Index], Locations[Index], HitFroms[Index]);
+		if (Batched[Index] != ByAngle || Single != ByAngle)
+		{
+			++Mismatches;
+			AddError(FString::Printf(TEXT("Hit %d: forward %s location %s hit %s, %s by angle, %s single, %s batched"),
+				Index, *Forwards[Index].ToString(), *Locations[Index].ToString(), *HitFroms[Index].ToString(),
+				DirectionName(ByAngle), DirectionName(Single), DirectionName(Batched[Index])));
+		}
+	}
+	TestEqual(TEXT("Mismatches"), Mismatches, 0);
+
+	return true;
+}
+
+#endif
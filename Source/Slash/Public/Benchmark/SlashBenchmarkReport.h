@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Per-frame timing capture shared by the benchmark and input replays.
+ * Collects frame and game thread times, spawns and garbage collections between Begin and End
+ * and writes them as <ReportPath>.csv (per frame) and <ReportPath>.json (summary and benchmark timers).
+ */
+class SLASH_API FSlashBenchmarkReport
+{
+public:
+	~FSlashBenchmarkReport();
+
+	void Begin(UWorld* World);
+	void End();
+
+	/** Called once per frame while measuring */
+	void RecordFrame();
+
+	/** WriteHeader adds the caller's own fields (seed, population...) to the top of the summary */
+	void Write(const FString& ReportPath, TFunctionRef<void(TJsonWriter<>&)> WriteHeader) const;
+
+	FORCEINLINE bool IsMeasuring() const { return bMeasuring; }
+	FORCEINLINE int32 GetNumFrames() const { return FrameTimesMs.Num(); }
+
+private:
+	void OnActorSpawned(AActor* Actor);
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	TWeakObjectPtr<UWorld> World;
+	bool bMeasuring = false;
+	double LastFrameWallTime = 0.0;
+	double StartWallTime = 0.0;
+	double EndWallTime = 0.0;
+
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+
+	uint32 NumSpawns = 0;
+	uint32 NumGarbageCollections = 0;
+	double GarbageCollectionMs = 0.0;
+	double GarbageCollectionStart = 0.0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle PreGarbageCollectHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SlashBenchmarkSettings.generated.h"
+
+class AEnemy;
+class ASlashCharacter;
+class ABreakableActor;
+class AItem;
+class AWeapon;
+class UStaticMesh;
+
+/** What USlashBenchmarkSubsystem spawns, counts can be overridden on the command line */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Slash Benchmark"))
+class SLASH_API USlashBenchmarkSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	USlashBenchmarkSettings();
+
+	UPROPERTY(Config, EditAnywhere, Category = "Arena")
+	FVector ArenaOrigin = FVector::ZeroVector;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Arena", meta = (ClampMin = "1000"))
+	double ArenaHalfExtent = 5000.0;
+
+	/** Scaled to cover the arena, leave empty to rely on the level's own ground */
+	UPROPERTY(Config, EditAnywhere, Category = "Arena")
+	TSoftObjectPtr<UStaticMesh> FloorMesh;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Arena", meta = (ClampMin = "0"))
+	int32 NumPatrolPoints = 8;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population")
+	TArray<TSoftClassPtr<AEnemy>> EnemyClasses;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population")
+	TSoftClassPtr<ASlashCharacter> StandInClass;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population")
+	TSoftClassPtr<AWeapon> StandInWeaponClass;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population")
+	TArray<TSoftClassPtr<ABreakableActor>> BreakableClasses;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population")
+	TArray<TSoftClassPtr<AItem>> PickupClasses;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population", meta = (ClampMin = "0"))
+	int32 NumEnemies = 100;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population", meta = (ClampMin = "0"))
+	int32 NumStandIns = 4;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population", meta = (ClampMin = "0"))
+	int32 NumBreakables = 50;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Population", meta = (ClampMin = "0"))
+	int32 NumPickups = 50;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Run", meta = (ClampMin = "1"))
+	float Duration = 30.f;
+
+	/** Simulated seconds before measuring starts */
+	UPROPERTY(Config, EditAnywhere, Category = "Run", meta = (ClampMin = "0"))
+	float Warmup = 2.f;
+
+	/** Fixed simulation rate, so the amount of simulated work doesn't depend on the machine */
+	UPROPERTY(Config, EditAnywhere, Category = "Run", meta = (ClampMin = "1"))
+	float FixedFrameRate = 30.f;
+
+	/** Seconds between scripted stand-in attacks */
+	UPROPERTY(Config, EditAnywhere, Category = "Run", meta = (ClampMin = "0.1"))
+	float AttackInterval = 1.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Run")
+	int32 Seed = 1337;
+};
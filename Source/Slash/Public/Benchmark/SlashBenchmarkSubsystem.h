@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Benchmark/SlashBenchmarkReport.h"
+#include "SlashBenchmarkSubsystem.generated.h"
+
+class AEnemy;
+class ASlashCharacter;
+
+/**
+ * Headless combat benchmark, only created when the game is started with -SlashBenchmark, e.g.
+ *   UnrealEditor-Cmd Slash.uproject <ArenaMap> -game -nullrhi -unattended -SlashBenchmark -BenchSeconds=60 -BenchEnemies=300
+ * Builds an arena around USlashBenchmarkSettings::ArenaOrigin (the map should have navmesh there for patrols),
+ * spawns enemies, breakables, pickups and stand-in characters that attack on a script, simulates at a fixed
+ * frame rate from a fixed seed and writes per-frame CSV plus a JSON summary to Saved/Benchmarks, then exits.
+ * Overrides: -BenchSeed= -BenchSeconds= -BenchWarmup= -BenchFps= -BenchEnemies= -BenchStandIns=
+ * -BenchBreakables= -BenchPickups= -BenchReport=<path without extension> -BenchNoExit
+ * Enemy animation cost: run -BenchEnemies=200 -BenchStandIns=0 before and after reparenting the enemy anim
+ * blueprints to UEnemyAnimInstance and compare gameThreadMs, population.threadSafeEnemyAnims says which is which.
+ */
+UCLASS()
+class SLASH_API USlashBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FBenchmarkOptions
+	{
+		int32 Seed;
+		float Duration;
+		float Warmup;
+		float FixedFrameRate;
+		int32 NumEnemies;
+		int32 NumStandIns;
+		int32 NumBreakables;
+		int32 NumPickups;
+		FString ReportPath;
+		bool bExitWhenDone;
+	};
+
+	void ParseOptions();
+	void GenerateArena();
+	void SpawnPopulation();
+	FVector RandomArenaLocation(double ZOffset);
+	void DriveStandIns();
+	void FinishRun();
+
+	FBenchmarkOptions Options;
+	FRandomStream Stream;
+
+	UPROPERTY()
+	TArray<ASlashCharacter*> StandIns;
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	UPROPERTY()
+	TArray<AActor*> PatrolPoints;
+
+	FSlashBenchmarkReport Report;
+	bool bRunning = false;
+	double SimulatedTime = 0.0;
+	double NextAttackTime = 0.0;
+};
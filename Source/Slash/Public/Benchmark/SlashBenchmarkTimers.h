@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Named cycle accumulator for USlashBenchmarkSubsystem's per-class report.
+ * Timers register themselves on construction, scopes only read the clock while a benchmark runs.
+ * Game thread only.
+ */
+struct SLASH_API FSlashBenchmarkTimer
+{
+	explicit FSlashBenchmarkTimer(const TCHAR* InName);
+
+	const TCHAR* Name;
+	uint64 Cycles = 0;
+	uint32 Calls = 0;
+	FSlashBenchmarkTimer* Next = nullptr;
+
+	static FSlashBenchmarkTimer* First;
+	static bool bEnabled;
+
+	/** Traces issued by gameplay code (weapon sweeps, sight checks) */
+	static uint32 NumTraces;
+
+	static void ResetAll();
+};
+
+struct FSlashBenchmarkScope
+{
+	FORCEINLINE explicit FSlashBenchmarkScope(FSlashBenchmarkTimer& InTimer)
+		: Timer(FSlashBenchmarkTimer::bEnabled ? &InTimer : nullptr)
+		, StartCycles(Timer ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	FORCEINLINE ~FSlashBenchmarkScope()
+	{
+		if (Timer)
+		{
+			Timer->Cycles += FPlatformTime::Cycles64() - StartCycles;
+			++Timer->Calls;
+		}
+	}
+
+private:
+	FSlashBenchmarkTimer* Timer;
+	uint64 StartCycles;
+};
+
+#define SLASH_BENCHMARK_SCOPE(TimerName) \
+	static FSlashBenchmarkTimer PREPROCESSOR_JOIN(SlashBenchmarkTimer, __LINE__)(TEXT(TimerName)); \
+	FSlashBenchmarkScope PREPROCESSOR_JOIN(SlashBenchmarkScope, __LINE__)(PREPROCESSOR_JOIN(SlashBenchmarkTimer, __LINE__))
+
+#define SLASH_BENCHMARK_COUNT_TRACE() ++FSlashBenchmarkTimer::NumTraces
@@ -18,6 +18,7 @@ class SLASH_API ABreakableActor : public AActor, public IHitInterface
 public:	
 	ABreakableActor();
 	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 
@@ -33,10 +34,15 @@ protected:
 	UFUNCTION()
 	void OnBreak(const FChaosBreakEvent& BreakEvent);
 
+	UFUNCTION()
+	void OnRep_Broken();
+
 private:
 	UPROPERTY(EditAnywhere, Category = "Breakable Properties")
 	TArray<TSubclassOf<class ATreasure>> TreasureClasses;
 
+	/** Set by the server's hit, frees the capsule on clients even when they missed the weapon's break fields */
+	UPROPERTY(ReplicatedUsing = OnRep_Broken)
 	bool bBroken = false;
 };
  
\ No newline at end of file
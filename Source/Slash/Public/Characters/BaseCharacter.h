@@ -7,10 +7,12 @@
 #include "GameFramework/Character.h"
 #include "Interfaces/HitInterface.h"
 #include "Characters/CharacterTypes.h"
+#include "Characters/MontageSectionCache.h"
 #include "BaseCharacter.generated.h"
 
 class AWeapon;
 class UAttributeComponent;
+class UFactionComponent;
 class UAnimMontage;
 
 UCLASS()
@@ -19,11 +21,16 @@ class SLASH_API ABaseCharacter : public ACharacter, public IHitInterface
 	GENERATED_BODY()
 
 public:
-	ABaseCharacter();
+	ABaseCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Hit react direction for the next GetHit, set by weapons that classify a whole sweep at once */
+	void SetIncomingHitDirection(EHitReactDirection Direction);
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 	virtual bool CanAttack();
 	virtual void Attack(const FInputActionValue& Value);
@@ -34,6 +41,8 @@ protected:
 
 	void DisableCapsule();
 	void DisableMeshCollision();
+	void EnableCapsule();
+	void EnableMeshCollision();
 	virtual void HandleDamage(float DamageAmount);
 	void DirectionalHitReact(const FVector& ImpactPoint);
 	void PlayHitSound(const FVector& ImpactPoint);
@@ -41,11 +50,18 @@ protected:
 	bool IsAlive();
 
 	/** Montage */
-	void PlayHitReactMontage(const FName& SectionName);
-	void PlayAttackMontage(UAnimMontage* AttackMontage);
+	void PlayHitReactMontage(EHitReactDirection Direction);
+	int32 PlayAttackMontage(UAnimMontage* AttackMontage);
 	void StopAttackMontage(UAnimMontage* AttackMontage);
 	virtual int32 PlayDeathMontage();
 	virtual void PlayDodgeMontage();
+	void PlayMontageSection(UAnimMontage* Montage, int32 Section);
+
+	/**
+	 * Built on first use of each montage. Slots are added by the first call that passes SlotNames, even after the
+	 * montage was cached without them, later calls must pass the same names.
+	 */
+	const FMontageSectionCache& GetSectionCache(const UAnimMontage* Montage, TArrayView<const FName> SlotNames = TArrayView<const FName>());
 
 	UFUNCTION(BLueprintCallable)
 	FVector GetTranslationWarpTarget();
@@ -62,10 +78,24 @@ protected:
 	UFUNCTION(BLueprintCallable)
 	void SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled);
 
-	UPROPERTY(VisibleAnywhere)
+	/** Networking, combat outcomes are decided on the server and only presented by clients */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastPlayMontageSection(UAnimMontage* Montage, int32 Section);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastHitReact(EHitReactDirection Direction);
+	virtual void MulticastHitReact_Implementation(EHitReactDirection Direction);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastHitEffects(FVector_NetQuantize ImpactPoint);
+
+	UFUNCTION()
+	virtual void OnRep_DeathPose();
+
+	UPROPERTY(VisibleAnywhere, Replicated)
 	AWeapon* Equipped1hWeapon;
 
-	UPROPERTY(VisibleAnywhere)
+	UPROPERTY(VisibleAnywhere, Replicated)
 	AWeapon* Equipped2hWeapon;
 
 	UPROPERTY(EditDefaultsOnly, Category = Combat)
@@ -77,17 +107,20 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UAttributeComponent* Attributes;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	UFactionComponent* Faction;
+
 	UPROPERTY(BlueprintReadOnly, Category = Combat)
 	AActor* CombatTarget;
 
 	UPROPERTY(EditAnywhere, Category = Combat)
 	double WarpTargetDistance = 75.f;
 
-	UPROPERTY(BlueprintReadOnly)
-	TEnumAsByte<EDeathPose> DeathPose;
+	/** EDP_MAX while alive */
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_DeathPose)
+	TEnumAsByte<EDeathPose> DeathPose = EDeathPose::EDP_MAX;
 
 private:
-	void PlayMontageSection(UAnimMontage* Montage, const FName& SectionName);
 	int32 PlayRandomMontageSection(UAnimMontage* Montage);
 
 	UPROPERTY(EditAnywhere, Category = Combat)
@@ -105,6 +138,16 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = Combat)
 	UAnimMontage* DodgeMontage;
 
+	/** Relative chance of a section when one is picked at random (attacks, deaths), sections not listed weigh 1 */
+	UPROPERTY(EditDefaultsOnly, Category = Combat)
+	TMap<FName, float> SectionWeights;
+
+	TMap<TObjectKey<UAnimMontage>, FMontageSectionCache> SectionCaches;
+
+	TOptional<EHitReactDirection> IncomingHitDirection;
+
 public:
 	FORCEINLINE TEnumAsByte<EDeathPose> GetDeathPose() const { return DeathPose; }
+	FORCEINLINE UFactionComponent* GetFaction() const { return Faction; }
+	FORCEINLINE AActor* GetCombatTarget() const { return CombatTarget; }
 };
@@ -42,4 +42,64 @@ enum class EEnemyState : uint8
 	EES_Chasing UMETA(DisplayName = "Chasing"),
 	EES_Attacking UMETA(DisplayName = "Attacking"),
 	EES_Engaged UMETA(DisplayName = "Engaged")
-};
\ No newline at end of file
+};
+
+UENUM(BlueprintType)
+enum class EEnemyLODTier : uint8
+{
+	ELT_Engaged UMETA(DisplayName = "Engaged"),
+	ELT_Near UMETA(DisplayName = "Near"),
+	ELT_Far UMETA(DisplayName = "Far"),
+	ELT_Dormant UMETA(DisplayName = "Dormant"),
+
+	ELT_MAX UMETA(DisplayName = "DefaultMAX")
+};
+
+UENUM(BlueprintType)
+enum class EAttributeId : uint8
+{
+	EAI_Health UMETA(DisplayName = "Health"),
+	EAI_Stamina UMETA(DisplayName = "Stamina"),
+	EAI_Gold UMETA(DisplayName = "Gold"),
+	EAI_Souls UMETA(DisplayName = "Souls"),
+	EAI_DodgeCost UMETA(DisplayName = "Dodge Cost"),
+
+	EAI_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EFaction : uint8
+{
+	EF_Neutral UMETA(DisplayName = "Neutral"),
+	EF_Player UMETA(DisplayName = "Player"),
+	EF_Enemy UMETA(DisplayName = "Enemy"),
+
+	EF_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EWeaponType : uint8
+{
+	EWT_OneHanded UMETA(DisplayName = "One-Handed"),
+	EWT_TwoHanded UMETA(DisplayName = "Two-Handed")
+};
+
+UENUM(BlueprintType)
+enum class EHitReactDirection : uint8
+{
+	EHR_FromFront UMETA(DisplayName = "From Front"),
+	EHR_FromBack UMETA(DisplayName = "From Back"),
+	EHR_FromLeft UMETA(DisplayName = "From Left"),
+	EHR_FromRight UMETA(DisplayName = "From Right"),
+
+	EHR_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EEquipMontageSection : uint8
+{
+	EEM_Equip UMETA(DisplayName = "Equip"),
+	EEM_Unequip UMETA(DisplayName = "Unequip"),
+
+	EEM_MAX UMETA(Hidden)
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimMontage;
+
+/**
+ * Section lookups for one montage, resolved once so playing a section needs neither name lookups nor
+ * section queries on the montage. Named slots map a caller's enum (e.g. hit react directions) to sections,
+ * random picks are weighted by section name.
+ */
+class SLASH_API FMontageSectionCache
+{
+public:
+	/** Slots the montage doesn't have resolve to INDEX_NONE, sections without a weight weigh 1 */
+	void Build(const UAnimMontage* Montage, TArrayView<const FName> SlotNames, const TMap<FName, float>& Weights);
+
+	/** Replaces the named slots only */
+	void BuildSlots(const UAnimMontage* Montage, TArrayView<const FName> SlotNames);
+
+	/** Section index, INDEX_NONE when the montage has no sections or all weights are 0 */
+	int32 PickWeighted(FRandomStream& Stream) const;
+
+	int32 GetSlotSection(int32 Slot) const;
+
+	/** 0 for sections out of range */
+	float GetSectionWeight(int32 Section) const;
+
+private:
+	TArray<float, TInlineAllocator<8>> SectionStartTimes;
+	TArray<float, TInlineAllocator<8>> CumulativeWeights;
+	TArray<int32, TInlineAllocator<4>> SlotSections;
+
+public:
+	FORCEINLINE int32 GetNumSections() const { return SectionStartTimes.Num(); }
+	FORCEINLINE int32 GetNumSlots() const { return SlotSections.Num(); }
+	FORCEINLINE float GetSectionStartTime(int32 Section) const { return SectionStartTimes[Section]; }
+};
@@ -27,17 +27,20 @@ class SLASH_API ASlashCharacter : public ABaseCharacter, public IPickupInterface
 
 public:
 	ASlashCharacter();
-	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	virtual void Jump() override;
+	virtual void PawnClientRestart() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void SetOverlappingItem(AItem* Item) override;
 	virtual void AddSouls(ASoul* Soul) override;
 	virtual bool AddHealth(AHealth* Health) override;
 	virtual void AddGold(ATreasure* Treasure) override;
 
+	/** Runs the callback bound to Action, used by UInputReplaySubsystem */
+	void ReplayInput(const UInputAction* Action, const FInputActionValue& Value);
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -79,8 +82,9 @@ protected:
 	void Dodge(const FInputActionValue& Value);
 
 	/** Combat */
+	UAnimMontage* GetAttackMontage() const;
 	void EquipWeapon(AWeapon* Weapon);
-	void PlayEquipMontage(const FName& SectionName, UAnimMontage* EquipMontage);
+	void PlayEquipMontage(EEquipMontageSection Section, UAnimMontage* EquipMontage);
 	virtual bool CanAttack() override;
 	virtual void AttackEnd() override;
 	virtual void DodgeEnd() override;
@@ -90,7 +94,10 @@ protected:
 	bool CanArm2h();
 	void Arm();
 	void Disarm();
+	UAnimMontage* GetEquipMontage() const;
 	virtual void Die_Implementation() override;
+	virtual void MulticastHitReact_Implementation(EHitReactDirection Direction) override;
+	virtual void OnRep_DeathPose() override;
 	bool HasEnoughStamina();
 	bool IsOccupied();
 
@@ -106,10 +113,38 @@ protected:
 	UFUNCTION(BLueprintCallable)
 	void HitReactEnd();
 
+	/** Networking, attacks and dodges are predicted by the owning client and confirmed or rejected by the server */
+	UFUNCTION(Server, Reliable)
+	void ServerAttack(int32 Section);
+
+	UFUNCTION(Server, Reliable)
+	void ServerDodge();
+
+	UFUNCTION(Client, Reliable)
+	void ClientRejectAction(EActionState ServerActionState);
+
+	UFUNCTION(Server, Reliable)
+	void ServerEKeyPressed();
+
+	UFUNCTION(Server, Reliable)
+	void ServerNum1KeyPressed();
+
+	UFUNCTION(Server, Reliable)
+	void ServerNum2KeyPressed();
+
+	/**
+	 * Reliable unlike the hit multicasts: it plays the draw and sets EAS_EquippingWeapon on proxies, a dropped
+	 * one skips the draw and nothing resends it. The weapon's socket is not at stake, it reaches clients through
+	 * the weapon's attachment replication. Equips are rare, hit reacts and effects are frequent and the next hit
+	 * replaces a lost one.
+	 */
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastPlayEquipMontage(EEquipMontageSection Section, UAnimMontage* EquipMontage);
+
 private:
 	bool IsUnoccupied();
+	void InitializeLocalPlayer();
 	void InitializeSlashOverlay(APlayerController* PlayerController);
-	void SetHUDHealth();
 
 	/** Character Components */
 	UPROPERTY(VisibleAnywhere)
@@ -127,7 +162,7 @@ private:
 	UPROPERTY(VisibleInstanceOnly)
 	AItem* OverlappingItem;
 
-	UPROPERTY(VisibleAnywhere)
+	UPROPERTY(VisibleAnywhere, Replicated)
 	AWeapon* ActiveWeapon;
 
 	/** Animation Montages */
@@ -137,15 +172,18 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = Montages)
 	UAnimMontage* EquipMontage_2h;
 
-	/** State variables */
+	/** State variables, the owning client predicts its own ActionState */
+	UPROPERTY(Replicated)
 	ECharacterState CharacterState = ECharacterState::ECS_Unequipped;
 
-	UPROPERTY(BlueprintReadWrite, meta = (AllowPrivateAccess = "true"))
+	UPROPERTY(BlueprintReadWrite, Replicated, meta = (AllowPrivateAccess = "true"))
 	EActionState ActionState = EActionState::EAS_Unoccupied;
 
 	UPROPERTY()
 	USlashOverlay* SlashOverlay;
 
+	friend class USlashBenchmarkSubsystem;
+
 public:
 	FORCEINLINE ECharacterState GetCharacterState() const { return CharacterState; }
 	FORCEINLINE EActionState GetActionState() const { return ActionState; }
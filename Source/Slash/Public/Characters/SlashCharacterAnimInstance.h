@@ -10,6 +10,10 @@
 class ASlashCharacter;
 class UCharacterMovementComponent;
 
+/**
+ * Copies the character's state once on the game thread, everything derived from it is computed in
+ * NativeThreadSafeUpdateAnimation so the graph can run on a worker thread (a.ParallelAnimUpdate).
+ */
 UCLASS()
 class SLASH_API USlashCharacterAnimInstance : public UAnimInstance
 {
@@ -18,6 +22,7 @@ class SLASH_API USlashCharacterAnimInstance : public UAnimInstance
 public:
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
 
 	UPROPERTY(BlueprintReadOnly)
 	ASlashCharacter* SlashCharacter;
@@ -39,4 +44,16 @@ public:
 
 	UPROPERTY(BlueprintReadOnly, Category = Movement)
 	TEnumAsByte<EDeathPose> DeathPose;
+
+private:
+	struct FPawnSnapshot
+	{
+		FVector Velocity = FVector::ZeroVector;
+		bool bIsFalling = false;
+		ECharacterState CharacterState = ECharacterState::ECS_Unequipped;
+		EActionState ActionState = EActionState::EAS_Unoccupied;
+		EDeathPose DeathPose = EDeathPose::EDP_Death1;
+	};
+
+	FPawnSnapshot Snapshot;
 };
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Blade poses a weapon passes through between two frames. The socket the blade hangs off is moved along the screw
+ * between its two transforms: the rotation is slerped and the location turns with it about the same axis, so a blade
+ * swung around a shoulder or an elbow follows the arc of the swing instead of cutting across its chord.
+ */
+struct SLASH_API FBladeSweep
+{
+	/** Trace start in the socket's space, its rotation is the trace box's */
+	FTransform LocalStart;
+
+	/** Trace end in the socket's space */
+	FVector LocalEnd = FVector::ZeroVector;
+
+	void SetFrame(const FTransform& InFrom, const FTransform& InTo);
+
+	/** Sub-steps that keep every point of the blade within MaxStepDistance of its previous pose, not capped */
+	int32 GetNumSubsteps(double MaxStepDistance) const;
+
+	/** Alpha 0 is the frame's first pose, 1 its last */
+	void GetPose(double Alpha, FVector& OutStart, FVector& OutEnd, FQuat& OutRotation) const;
+
+private:
+	FTransform From;
+	FTransform To;
+
+	/** Rotation from the first pose to the last, about Axis through Pivot, and the travel along the axis */
+	FVector Axis = FVector::UpVector;
+	double Angle = 0.0;
+	FVector Pivot = FVector::ZeroVector;
+	FVector AxialTravel = FVector::ZeroVector;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Fixed-capacity single-producer single-consumer queue. Neither side locks or allocates,
+ * pushing onto a full buffer fails and leaves it to the caller to drop the element.
+ */
+template<typename ElementType, uint32 Capacity>
+class TCombatEventRingBuffer
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	/** Producer side */
+	bool Push(const ElementType& Element)
+	{
+		const uint32 Head = HeadIndex.load(std::memory_order_relaxed);
+		if (Head - TailIndex.load(std::memory_order_acquire) >= Capacity) return false;
+
+		Elements[Head & Mask] = Element;
+		HeadIndex.store(Head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Consumer side */
+	bool Pop(ElementType& OutElement)
+	{
+		const uint32 Tail = TailIndex.load(std::memory_order_relaxed);
+		if (Tail == HeadIndex.load(std::memory_order_acquire)) return false;
+
+		OutElement = Elements[Tail & Mask];
+		TailIndex.store(Tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	uint32 Num() const
+	{
+		return HeadIndex.load(std::memory_order_acquire) - TailIndex.load(std::memory_order_acquire);
+	}
+
+private:
+	static constexpr uint32 Mask = Capacity - 1;
+
+	// Kept on separate cache lines so the two threads don't invalidate each other's index
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> HeadIndex { 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> TailIndex { 0 };
+
+	ElementType Elements[Capacity];
+};
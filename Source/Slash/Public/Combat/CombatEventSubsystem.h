@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/CombatEventWriter.h"
+#include "CombatEventSubsystem.generated.h"
+
+/**
+ * Records hits, damage, deaths, dodges and pickups for balance and performance analysis.
+ * Recording only copies the event into a lock-free ring buffer, a worker thread writes the
+ * binary log to Saved/Logs/CombatEvents-<time>.bin. Toggled with Slash.CombatLog.Enabled.
+ */
+UCLASS()
+class SLASH_API UCombatEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	void RecordEvent(ECombatEventType Type, const AActor* Attacker, const AActor* Victim, float Amount, const FVector& Location);
+
+	/** Records into the subsystem of WorldContextObject's world, if there is one */
+	static void Record(const UObject* WorldContextObject, ECombatEventType Type, const AActor* Attacker, const AActor* Victim, float Amount, const FVector& Location);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TUniquePtr<FCombatEventWriter> Writer;
+};
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Combat/CombatEventRingBuffer.h"
+
+enum class ECombatEventType : uint8
+{
+	ECE_Hit,
+	ECE_Damage,
+	ECE_Death,
+	ECE_Dodge,
+	ECE_Pickup,
+
+	ECE_MAX
+};
+
+/** Actors are identified by their UObject unique id, which is stable for the session */
+struct FCombatEvent
+{
+	uint64 Frame;
+	FVector3f Location;
+	float Amount;
+	uint32 AttackerId;
+	uint32 VictimId;
+	ECombatEventType Type;
+};
+
+/**
+ * Drains combat events on its own thread into a binary log.
+ * The file starts with a magic number and version, followed by fixed 33 byte records
+ * (frame, type, attacker, victim, amount, location), all little endian.
+ */
+class SLASH_API FCombatEventWriter : public FRunnable
+{
+public:
+	static constexpr uint32 FileMagic = 0x56454353; // "SCEV"
+	static constexpr uint32 FileVersion = 1;
+	static constexpr uint32 BufferCapacity = 8192;
+
+	explicit FCombatEventWriter(const FString& InFilename);
+	virtual ~FCombatEventWriter() override;
+
+	/** Game thread only. Returns false and counts a drop when the worker has fallen behind */
+	bool Enqueue(const FCombatEvent& Event);
+
+	/** Joins the worker, writes whatever is still queued and closes the file */
+	void Shutdown();
+
+	/** <FRunnable> */
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	/** </FRunnable> */
+
+	void LogSummary() const;
+
+private:
+	void Drain();
+	void WriteEvent(const FCombatEvent& Event);
+
+	TCombatEventRingBuffer<FCombatEvent, BufferCapacity> Events;
+
+	FString Filename;
+	TUniquePtr<FArchive> FileWriter;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping { false };
+
+	/** Aggregates, only touched by the worker until it has been joined */
+	uint32 EventCounts[static_cast<int32>(ECombatEventType::ECE_MAX)] = {};
+	double EventAmounts[static_cast<int32>(ECombatEventType::ECE_MAX)] = {};
+
+	uint32 NumDropped = 0;
+};
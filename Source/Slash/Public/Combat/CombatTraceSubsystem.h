@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "CombatTraceSubsystem.generated.h"
+
+class AWeapon;
+
+/**
+ * Runs weapon sweeps through the world's async trace queue instead of on the game thread.
+ * Sweeps queued during a frame are executed by the physics task threads at the end of that frame
+ * and their hits are handed back to the weapons on the next frame's tick (Slash.Combat.AsyncTraces).
+ */
+UCLASS()
+class SLASH_API UCombatTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	void QueueWeaponSweep(AWeapon* Weapon, uint32 SwingId, const FVector& Start, const FVector& End, const FQuat& Rotation, const FVector& HalfExtent, const FCollisionObjectQueryParams& ObjectParams, const FCollisionQueryParams& QueryParams);
+
+	static bool IsAsyncEnabled();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FInFlightSweep
+	{
+		TWeakObjectPtr<AWeapon> Weapon;
+		uint32 SwingId;
+		FTraceHandle Handle;
+		uint64 FrameQueued;
+	};
+
+	void ResolveSweeps();
+
+	TArray<FInFlightSweep> InFlightSweeps;
+	TArray<FInFlightSweep> ResolvingSweeps;
+	FTraceDatum TraceData;
+};
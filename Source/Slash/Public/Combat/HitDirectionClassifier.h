@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Characters/CharacterTypes.h"
+
+/**
+ * Picks the hit react direction of a victim from where it was hit, in the victim's horizontal plane.
+ * Same quadrants as the original angle thresholds (front within 45 degrees, back beyond 135), but decided
+ * from the signs and squares of the dot and cross products only: no Acos, no normalisation, no branches.
+ */
+class SLASH_API FHitDirectionClassifier
+{
+public:
+	static EHitReactDirection Classify(const FVector& Forward, const FVector& Location, const FVector& HitFrom);
+
+	/** All views must have the same length, the loop has no data dependent branches */
+	static void ClassifyBatch(TArrayView<const FVector> Forwards, TArrayView<const FVector> Locations, TArrayView<const FVector> HitFroms, TArrayView<EHitReactDirection> OutDirections);
+
+	/**
+	 * Acos based reference the sign tests are checked against (Slash.Combat.HitDirection, Slash.Bench.HitDirection).
+	 * Its degrees are rounded, hits exactly on a quadrant edge may land on either side of it.
+	 */
+	static EHitReactDirection ClassifyByAngle(const FVector& Forward, const FVector& Location, const FVector& HitFrom);
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Remembers which actors a weapon swing has already hit and when.
+ * Lookups are hashed and the first few targets live inline, so sweeping through a crowd stays linear.
+ * A swing can be limited to a number of distinct targets (cleave) and may re-hit a target once its cooldown has passed.
+ */
+class SLASH_API FSwingHitRegistry
+{
+public:
+	/** Forgets all hits and starts a new swing id. MaxTargets <= 0 is unlimited, HitCooldown <= 0 hits each target once */
+	void BeginSwing(int32 InMaxTargets = 0, float InHitCooldown = 0.f);
+
+	/** Returns true and records the hit if Target may be hit at Time */
+	bool TryRegisterHit(AActor* Target, float Time);
+
+	bool IsCleaveExhausted() const;
+
+private:
+	TMap<TWeakObjectPtr<AActor>, float, TInlineSetAllocator<16>> LastHitTimes;
+	uint32 SwingId = 0;
+	int32 MaxTargets = 0;
+	float HitCooldown = 0.f;
+
+public:
+	FORCEINLINE uint32 GetSwingId() const { return SwingId; }
+	FORCEINLINE bool AllowsRehits() const { return HitCooldown > 0.f; }
+};
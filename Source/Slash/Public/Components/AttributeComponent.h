@@ -4,62 +4,194 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Components/AttributeSetData.h"
+#include "Characters/CharacterTypes.h"
 #include "AttributeComponent.generated.h"
 
+class UAttributeRegenSubsystem;
+class UFactionComponent;
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAttributePercentChanged, float /* Percent */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAttributeCountChanged, int32 /* Count */);
+
+enum class EAttributeModifierTarget : uint8
+{
+	EAMT_Max,
+	EAMT_Regen
+};
+
+enum class EAttributeModifierOp : uint8
+{
+	EAMO_Add,
+	EAMO_Multiply
+};
+
+/** Buff or debuff, additive modifiers are summed before multiplicative ones are applied */
+struct FAttributeModifier
+{
+	int32 Handle;
+	EAttributeId Attribute;
+	EAttributeModifierTarget Target;
+	EAttributeModifierOp Op;
+	float Magnitude;
+};
+
+/**
+ * Attribute values packed in one array indexed by EAttributeId. Limits and regen come from
+ * AttributeOverrides, then the AttributeSet asset, then built-in defaults. Modifier stacks are evaluated
+ * on the first read after they change. Regen is applied by UAttributeRegenSubsystem.
+ * Values are owned by the server and replicated per element, push-model dirtied whenever one changes.
+ * Modifiers stay on the server, which replicates the effective max of each attribute the same way.
+ */
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SLASH_API UAttributeComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
 public:	
+	static constexpr int32 NumAttributes = static_cast<int32>(EAttributeId::EAI_MAX);
+
 	UAttributeComponent();
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-	void RegenStamina(float DeltaTime);
+	virtual void PostLoad() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * Change events, broadcast at most once per attribute per frame from the component's tick,
+	 * which only runs on frames where a bound attribute changed by more than BroadcastTolerance
+	 */
+	FOnAttributePercentChanged OnHealthChanged;
+	FOnAttributePercentChanged OnStaminaChanged;
+	FOnAttributeCountChanged OnGoldChanged;
+	FOnAttributeCountChanged OnSoulsChanged;
+
+	/** Broadcasts every attribute on the next tick, e.g. after binding a new listener */
+	void BroadcastAll();
+
+	float GetMax(EAttributeId Id) const;
+	float GetRegenRate(EAttributeId Id) const;
+	float GetPercent(EAttributeId Id) const;
+	void SetValue(EAttributeId Id, float NewValue);
+
+	/** Returns a handle for RemoveModifier */
+	int32 AddModifier(EAttributeId Attribute, EAttributeModifierTarget Target, EAttributeModifierOp Op, float Magnitude);
+	void RemoveModifier(int32 Handle);
+
+	/**
+	 * Moves every regenerating attribute towards its max (or min, for negative rates) and returns whether any
+	 * still has further to go, never for a dead owner. Only touches this component, change events are raised by FlushRegenChanges.
+	 */
+	bool ApplyRegen(float DeltaTime);
+	void FlushRegenChanges();
 
 protected:
+	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-	// Current Health
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	float Health;
+	void ResolveDefinitions();
+	void MigrateDeprecatedAttributes();
+	void EvaluateModifiers() const;
+	bool NeedsRegen(EAttributeId Id) const;
+	bool NeedsRegen() const;
+	void UpdateRegenActivation();
+	bool IsOwnerDead() const;
 
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	float MaxHealth;
+	UFUNCTION()
+	void OnRep_Values();
 
-	// Current Stamina
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	float Stamina;
+	UFUNCTION()
+	void OnRep_Maxes();
 
 	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	float MaxStamina;
+	UAttributeSetData* AttributeSet;
 
+	/** Replaces the set's definition of an attribute for this component only */
 	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	float StaminaRegenRate = 3.f;
+	TMap<EAttributeId, FAttributeDefinition> AttributeOverrides;
 
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	int32 Gold;
+	/** Attributes saved before attribute sets, moved into AttributeOverrides on load */
+	UPROPERTY()
+	float Health_DEPRECATED = 0.f;
 
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	int32 Souls;
+	UPROPERTY()
+	float MaxHealth_DEPRECATED = 0.f;
 
-	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
-	int32 DodgeCost = 15.f;
+	UPROPERTY()
+	float Stamina_DEPRECATED = 0.f;
+
+	UPROPERTY()
+	float MaxStamina_DEPRECATED = 0.f;
+
+	UPROPERTY()
+	float StaminaRegenRate_DEPRECATED = 3.f;
+
+	UPROPERTY()
+	int32 Gold_DEPRECATED = 0;
+
+	UPROPERTY()
+	int32 Souls_DEPRECATED = 0;
+
+	UPROPERTY()
+	int32 DodgeCost_DEPRECATED = 15;
+
+	FAttributeDefinition Definitions[NumAttributes];
+
+	/** Each element is its own replicated property, only the ones that changed are sent */
+	UPROPERTY(ReplicatedUsing = OnRep_Values)
+	float Values[NumAttributes] = {};
+
+	/** Effective max as evaluated on the server, clients read their limits from here */
+	UPROPERTY(ReplicatedUsing = OnRep_Maxes)
+	float Maxes[NumAttributes] = {};
+
+	TArray<FAttributeModifier, TInlineAllocator<4>> Modifiers;
+	int32 NextModifierHandle = 0;
+	mutable float EffectiveMax[NumAttributes] = {};
+	mutable float EffectiveRegen[NumAttributes] = {};
+	mutable bool bModifiersDirty = true;
+
+	static constexpr float BroadcastTolerance = 0.001f;
+
+	/** Every change to Values goes through here, it dirties the element for replication and for broadcasting */
+	void MarkValueDirty(int32 Index);
+	void UpdateReplicatedMax(EAttributeId Id);
+	void MarkDirty(EAttributeId Id);
+	bool HasListeners() const;
+	void BroadcastChanges();
+
+	uint32 DirtyAttributes = 0;
+	uint32 RegenChangedAttributes = 0;
+	float BroadcastHealthPercent = -1.f;
+	float BroadcastStaminaPercent = -1.f;
+	int32 BroadcastGold = INDEX_NONE;
+	int32 BroadcastSouls = INDEX_NONE;
+
+	UAttributeRegenSubsystem* RegenSubsystem = nullptr;
+	int32 RegenIndex = INDEX_NONE;
+
+	/** Owner's faction, its Dead flag stops regen */
+	UFactionComponent* Faction = nullptr;
+
+	friend class UAttributeRegenSubsystem;
 
 public:
 	void ReceiveDamage(float Damage);
 	void UseStamina(float StaminaCost);
-	float GetHealthPercent();
-	float GetStaminaPercent();
-	bool IsAlive();
+	float GetHealthPercent() const;
+	float GetStaminaPercent() const;
+	bool IsAlive() const;
 	void AddSouls(int32 NumberOfSouls);
-	void AddHealth(int32 HealthAmount);
+	void AddHealth(float HealthAmount);
 	void AddGold(int32 AmountOfGold);
-
-	FORCEINLINE int32 GetGold() const { return Gold; }
-	FORCEINLINE int32 GetSouls() const { return Souls; }
-	FORCEINLINE int32 GetHealth() const { return Health; }
-	FORCEINLINE int32 GetDodgeCost() const { return DodgeCost; }
-	FORCEINLINE int32 GetStamina() const { return Stamina; }
+	void ResetAttributes();
+
+	FORCEINLINE float GetValue(EAttributeId Id) const { return Values[static_cast<int32>(Id)]; }
+	FORCEINLINE bool IsFull(EAttributeId Id) const { return GetValue(Id) >= GetMax(Id); }
+	FORCEINLINE int32 GetGold() const { return FMath::RoundToInt32(GetValue(EAttributeId::EAI_Gold)); }
+	FORCEINLINE int32 GetSouls() const { return FMath::RoundToInt32(GetValue(EAttributeId::EAI_Souls)); }
+	FORCEINLINE float GetHealth() const { return GetValue(EAttributeId::EAI_Health); }
+	FORCEINLINE float GetDodgeCost() const { return GetValue(EAttributeId::EAI_DodgeCost); }
+	FORCEINLINE float GetStamina() const { return GetValue(EAttributeId::EAI_Stamina); }
 };
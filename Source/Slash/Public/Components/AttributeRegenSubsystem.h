@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AttributeRegenSubsystem.generated.h"
+
+class UAttributeComponent;
+
+/**
+ * Applies attribute regen for every UAttributeComponent in the world at a fixed rate (Slash.Attributes.RegenHz).
+ * Only components with an attribute below its max (or above its min, for negative regen) are in the dense
+ * active list, they join when a value moves away from its regen target and leave once it is reached.
+ * Large lists are updated with ParallelFor (Slash.Attributes.RegenParallelThreshold), change events are
+ * raised afterwards on the game thread.
+ */
+UCLASS()
+class SLASH_API UAttributeRegenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	void Activate(UAttributeComponent* Attributes);
+	void Deactivate(UAttributeComponent* Attributes);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void RunStep(float StepTime);
+
+	UPROPERTY()
+	TArray<UAttributeComponent*> ActiveComponents;
+
+	TArray<bool> StillRegenerating;
+	float StepAccumulator = 0.f;
+
+public:
+	FORCEINLINE int32 GetNumActive() const { return ActiveComponents.Num(); }
+};
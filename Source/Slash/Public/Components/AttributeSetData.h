@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Characters/CharacterTypes.h"
+#include "AttributeSetData.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAttributeDefinition
+{
+	GENERATED_BODY()
+
+	FAttributeDefinition() = default;
+	FAttributeDefinition(float InMin, float InMax, float InDefault, float InRegenRate)
+		: Min(InMin), Max(InMax), Default(InDefault), RegenRate(InRegenRate)
+	{
+	}
+
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float Min = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float Max = 100.f;
+
+	/** Value on spawn */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float Default = 100.f;
+
+	/** Per second, towards Max */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float RegenRate = 0.f;
+};
+
+/**
+ * Attribute limits and regen shared by every character using the set, e.g. one per enemy type.
+ */
+UCLASS(BlueprintType)
+class SLASH_API UAttributeSetData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes")
+	TMap<EAttributeId, FAttributeDefinition> Definitions;
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Characters/CharacterTypes.h"
+#include "FactionComponent.generated.h"
+
+enum class EFactionStateFlags : uint8
+{
+	None = 0,
+	Engageable = 1 << 0,	// Enemies may pick this actor as a combat target
+	Dead = 1 << 1
+};
+ENUM_CLASS_FLAGS(EFactionStateFlags);
+
+/**
+ * Faction and combat state of a character, replacing the "Enemy", "EngageableTarget" and "Dead" actor tags.
+ * Whether two factions may damage each other is read from a fixed table instead of comparing names.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SLASH_API UFactionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFactionComponent();
+
+	/** Faction component of a character, nullptr for everything else (which counts as neutral and alive) */
+	static UFactionComponent* Find(const AActor* Actor);
+
+	static bool AreFriendly(EFaction A, EFaction B);
+	static bool AreFriendly(const AActor* A, const AActor* B);
+	static bool IsDead(const AActor* Actor);
+	static bool IsEngageable(const AActor* Actor);
+
+	FORCEINLINE void AddState(EFactionStateFlags Flags) { State |= Flags; }
+	FORCEINLINE void RemoveState(EFactionStateFlags Flags) { State &= ~Flags; }
+	FORCEINLINE bool HasState(EFactionStateFlags Flags) const { return EnumHasAllFlags(State, Flags); }
+
+private:
+	UPROPERTY(EditAnywhere, Category = "Faction")
+	EFaction Faction = EFaction::EF_Neutral;
+
+	EFactionStateFlags State = EFactionStateFlags::None;
+
+public:
+	FORCEINLINE EFaction GetFaction() const { return Faction; }
+	FORCEINLINE void SetFaction(EFaction NewFaction) { Faction = NewFaction; }
+};
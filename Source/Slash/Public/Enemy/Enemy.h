@@ -11,6 +11,8 @@ class UHealthBarComponent;
 class AAIController;
 class UPawnSensingComponent;
 class ASoul;
+class AEnemySpawner;
+enum class EEnemyAIEvent : uint8;
 
 UCLASS()
 class SLASH_API AEnemy : public ABaseCharacter
@@ -18,18 +20,25 @@ class SLASH_API AEnemy : public ABaseCharacter
 	GENERATED_BODY()
 
 public:
-	AEnemy();
+	AEnemy(const FObjectInitializer& ObjectInitializer);
 
 	/** <AActor> */
-	virtual void Tick(float DeltaTime) override;
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void Destroyed() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	/** </AActor> */
 
 	/** <IHitInterface> */
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 	/** </IHitInterface> */
 
+	void HandleAIEvent(EEnemyAIEvent Event); // Called by UEnemyAISubsystem
+
+	/** Pooling, called by AEnemySpawner */
+	void ParkForRespawn();
+	void Respawn(const FTransform& SpawnTransform);
+	void SetPatrolTargets(const TArray<AActor*>& NewPatrolTargets);
+
 protected:
 	/** <AActor> */
 	virtual void BeginPlay() override;
@@ -41,22 +50,45 @@ protected:
 	virtual void AttackEnd() override;
 	virtual void HandleDamage(float DamageAmount) override;
 	virtual void Die_Implementation() override;
+	virtual void OnRep_DeathPose() override;
 	void SpawnSoul();
 	/** <ABaseCharacter> */
 
-	UPROPERTY(BlueprintReadOnly)
+	/** Decided by the AI on the server, push-model replicated through SetEnemyState */
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_EnemyState)
 	EEnemyState EnemyState = EEnemyState::EES_Patrolling;
 
+	UFUNCTION()
+	void OnRep_EnemyState(EEnemyState OldState);
+
+	/**
+	 * Parked enemies are hidden without collision, so they stop being relevant before a property change could
+	 * reach clients. Reliable multicasts still go out on the open channels.
+	 */
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastSetParked(bool bParked);
+
 	UFUNCTION(BLueprintCallable)
 	void HitReactEnd();
 
 private:
 	/** AI Behaviour */
+	void SetEnemyState(EEnemyState NewState);
 	void InitializeEnemy();
 	void SpawnDefaultWeapon();
-	void CheckPatrolTarget();
+	void SetLODTier(EEnemyLODTier NewTier); // Called by UEnemyAISubsystem
+	void SetAnimationTickEnabled(bool bEnabled);
+	void SetParked(bool bParked);
+	void FreezeAnimation();
+	void ScheduleFreezeAnimation();
+	void RestoreAfterDeath();
+	void OnHealthChanged(float Percent); // Clients only, the server sets the health bar in HandleDamage
 	void CheckCombatTarget();
+	void ReachedPatrolTarget();
+	void LostCombatTarget();
+	void CombatTargetOutOfReach();
 	void PatrolTimerFinished();
+	void DeathTimerFinished();
 	void HideHealthBar();
 	void ShowHealthBar();
 	void LoseInterest();
@@ -76,12 +108,13 @@ private:
 	void MoveToTarget(AActor* Target);
 	AActor* ChoosePatrolTarget();
 
-	UFUNCTION()
-	void PawnSeen(APawn* SeenPawn); // Callback for OnPawnSeen in UPawnSensingComponent
+	bool CanSeePawn(APawn* Pawn);
+	void PawnSeen(APawn* SeenPawn); // Called by UEnemyAISubsystem's sight pass
 
 	UPROPERTY(VisibleAnywhere)
 	UHealthBarComponent* HealthBarWidget;
 
+	/** Only holds the sight radius and peripheral angle, sensing itself runs through UPawnSpatialGridSubsystem */
 	UPROPERTY(VisibleAnywhere)
 	UPawnSensingComponent* PawnSensor;
 
@@ -134,6 +167,23 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	float DeathLifeSpan = 8.f;
 
+	FTimerHandle DeathTimer;
+	FTimerHandle FreezeAnimationTimer;
+
+	/** Set when spawned by an AEnemySpawner, which recycles this enemy instead of destroying it */
+	UPROPERTY()
+	AEnemySpawner* Spawner;
+
 	UPROPERTY(EditAnywhere, Category = Combat)
 	TSubclassOf<ASoul> SoulClass;
+
+	UPROPERTY(VisibleInstanceOnly, Category = "AI LOD")
+	EEnemyLODTier LODTier = EEnemyLODTier::ELT_Near;
+
+	friend class UEnemyAISubsystem;
+
+public:
+	FORCEINLINE EEnemyLODTier GetLODTier() const { return LODTier; }
+	FORCEINLINE EEnemyState GetEnemyState() const { return EnemyState; }
+	FORCEINLINE void SetSpawner(AEnemySpawner* NewSpawner) { Spawner = NewSpawner; }
 };
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Characters/CharacterTypes.h"
+#include "EnemyAISettings.generated.h"
+
+USTRUCT(BlueprintType)
+struct FEnemyLODTierSettings
+{
+	GENERATED_BODY()
+
+	/** Character movement and AI controller tick interval, 0 = every frame */
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "0"))
+	float TickInterval = 0.f;
+
+	/** Skeletal mesh (animation) tick interval, 0 = every frame */
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "0"))
+	float AnimationTickInterval = 0.f;
+
+	/** Seconds between sight checks */
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "0.01"))
+	float SensingInterval = 0.5f;
+
+	/** Path following tick interval, 0 = every frame */
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "0"))
+	float PathingInterval = 0.f;
+};
+
+/**
+ * Tier thresholds and per-tier update rates for enemy AI level of detail, and the enemy animation budget.
+ * Enemies with a combat target are always Engaged, the rest are tiered by distance to the player.
+ * Dormant enemies (beyond FarDistance) are frozen entirely.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Enemy AI"))
+class SLASH_API UEnemyAISettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyAISettings();
+
+	const FEnemyLODTierSettings& GetTierSettings(EEnemyLODTier Tier) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	double NearDistance = 2500.0;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	double FarDistance = 6000.0;
+
+	/** Extra distance an enemy must cover before dropping to a lower tier, avoids flickering at the thresholds */
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	double TierHysteresis = 250.0;
+
+	/** Enemies that haven't been rendered recently drop one tier, ignored when the process can't render */
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	bool bDemoteWhenNotRendered = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD", meta = (EditCondition = "bDemoteWhenNotRendered"))
+	float RenderedGraceTime = 0.5f;
+
+	/**
+	 * Tick enemy meshes through the animation budget allocator, which lowers update rates and interpolates
+	 * the least significant meshes to stay within AnimationBudgetMs. Per-tier AnimationTickInterval is unused then.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Animation Budget")
+	bool bUseAnimationBudget = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Animation Budget", meta = (EditCondition = "bUseAnimationBudget", ClampMin = "0.1"))
+	float AnimationBudgetMs = 1.f;
+
+	/** Lowest update rate, in frames between updates, the allocator may throttle a mesh to */
+	UPROPERTY(Config, EditAnywhere, Category = "Animation Budget", meta = (EditCondition = "bUseAnimationBudget", ClampMin = "1"))
+	int32 AnimationBudgetMaxTickRate = 10;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	FEnemyLODTierSettings Engaged;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	FEnemyLODTierSettings Near;
+
+	UPROPERTY(Config, EditAnywhere, Category = "LOD")
+	FEnemyLODTierSettings Far;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Characters/CharacterTypes.h"
+#include "EnemyAISubsystem.generated.h"
+
+class AEnemy;
+
+enum class EEnemyAIEvent : uint8
+{
+	EAE_ReachedPatrolTarget,
+	EAE_LostCombatTarget,
+	EAE_CombatTargetOutOfReach,
+	EAE_CombatTargetInReach
+};
+
+/**
+ * Owns every live AEnemy and replaces their per-actor Tick with a single batched pass.
+ * Positions, states and squared radii are kept in parallel arrays, radius transitions are
+ * evaluated in one loop and the resulting events are dispatched under a per-frame budget
+ * (Slash.AI.BudgetMs). Events that don't fit are dropped and re-evaluated next frame.
+ * The same pass assigns each enemy an LOD tier (see UEnemyAISettings) and runs sight checks
+ * against UPawnSpatialGridSubsystem for enemies that are looking for a target.
+ * Decisions are only made on the server, which ranks LOD tiers by the nearest player.
+ * Network clients only assign LOD tiers and animation significance for their own view.
+ */
+UCLASS()
+class SLASH_API UEnemyAISubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	/** </UWorldSubsystem> */
+
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingEnemyEvent
+	{
+		TWeakObjectPtr<AEnemy> Enemy;
+		EEnemyAIEvent Event;
+	};
+
+	void GatherEnemyData();
+	void UpdateLODTiers();
+	EEnemyLODTier ComputeLODTier(int32 Index, double PlayerDistanceSquared) const;
+	void UpdateAnimationSignificance();
+	void UpdateSight(float DeltaTime);
+	void EvaluateTransitions();
+	void DispatchEvents();
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	/** Parallel to Enemies */
+	TArray<FVector> Locations;
+	TArray<FVector> TargetLocations;
+	TArray<bool> HasTarget;
+	TArray<EEnemyState> States;
+	TArray<double> PatrolRadiiSquared;
+	TArray<double> CombatRadiiSquared;
+	TArray<double> AttackRadiiSquared;
+	TArray<bool> Rendered;
+	TArray<EEnemyLODTier> LODTiers;
+	TArray<double> SightRadii;
+	TArray<float> SightHalfAngles;
+	TArray<float> SightTimers;
+
+	int32 TierCounts[static_cast<int32>(EEnemyLODTier::ELT_MAX)] = {};
+	TArray<FVector> PlayerLocations;
+
+	/** Same players as PlayerLocations, and what each is fighting, for the animation budget */
+	TArray<const APawn*> PlayerPawns;
+	TArray<const AActor*> PlayerTargets;
+
+	TArray<APawn*> SeenPawns;
+	TArray<FPendingEnemyEvent> PendingEvents;
+	int32 DispatchCursor = 0;
+
+	class IAnimationBudgetAllocator* AnimationBudget = nullptr;
+
+public:
+	FORCEINLINE int32 GetNumEnemies() const { return Enemies.Num(); }
+	FORCEINLINE int32 GetNumEnemiesInTier(EEnemyLODTier Tier) const { return TierCounts[static_cast<int32>(Tier)]; }
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Characters/CharacterTypes.h"
+#include "EnemyAnimInstance.generated.h"
+
+class AEnemy;
+class UCharacterMovementComponent;
+
+/**
+ * Enemy counterpart of USlashCharacterAnimInstance: the enemy is read once on the game thread
+ * and the graph variables are filled in NativeThreadSafeUpdateAnimation.
+ * To move an enemy anim blueprint onto worker threads, reparent it to this class (Class Settings > Parent Class),
+ * delete the Event Blueprint Update Animation graph that read the same values off the pawn, switch the graph to
+ * the inherited variables and enable Use Multi Threaded Animation Update. Enemies still on blueprint parents are
+ * counted in the benchmark report, see USlashBenchmarkSubsystem.
+ */
+UCLASS()
+class SLASH_API UEnemyAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NativeInitializeAnimation() override;
+	virtual void NativeUpdateAnimation(float DeltaTime) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
+
+	UPROPERTY(BlueprintReadOnly)
+	AEnemy* Enemy;
+
+	UPROPERTY(BlueprintReadOnly, Category = Movement)
+	UCharacterMovementComponent* EnemyMovement;
+
+	UPROPERTY(BlueprintReadOnly, Category = Movement)
+	float GroundSpeed;
+
+	UPROPERTY(BlueprintReadOnly, Category = Movement)
+	bool IsFalling;
+
+	UPROPERTY(BlueprintReadOnly, Category = Movement)
+	EEnemyState EnemyState;
+
+	UPROPERTY(BlueprintReadOnly, Category = Movement)
+	TEnumAsByte<EDeathPose> DeathPose;
+
+private:
+	struct FPawnSnapshot
+	{
+		FVector Velocity = FVector::ZeroVector;
+		bool bIsFalling = false;
+		EEnemyState EnemyState = EEnemyState::EES_Patrolling;
+		EDeathPose DeathPose = EDeathPose::EDP_Death1;
+	};
+
+	FPawnSnapshot Snapshot;
+};
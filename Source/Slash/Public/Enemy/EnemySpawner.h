@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EnemySpawner.generated.h"
+
+class AEnemy;
+
+/**
+ * Streams waves of enemies on the navmesh around the players, on the server only, enemies replicate to clients.
+ * Dead or distant enemies are parked hidden and reset on their next spawn instead of being destroyed.
+ */
+UCLASS()
+class SLASH_API AEnemySpawner : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AEnemySpawner();
+
+	void RecycleEnemy(AEnemy* Enemy); // Called by AEnemy once its death life span runs out
+
+protected:
+	/** <AActor> */
+	virtual void BeginPlay() override;
+	/** </AActor> */
+
+private:
+	void SpawnWave();
+	void RecycleDistantEnemies(TArrayView<const FVector> PlayerLocations);
+	AEnemy* AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform);
+	AEnemy* SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& SpawnTransform);
+
+	/** Around PlayerLocations[PlayerIndex], no closer than MinSpawnDistance to any player */
+	bool FindSpawnLocation(TArrayView<const FVector> PlayerLocations, int32 PlayerIndex, TSubclassOf<AEnemy> EnemyClass, FVector& OutLocation) const;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	TArray<TSubclassOf<AEnemy>> EnemyClasses;
+
+	/** Handed to every enemy this spawner creates */
+	UPROPERTY(EditInstanceOnly, Category = "Spawning")
+	TArray<AActor*> PatrolTargets;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	int32 WaveSize = 4;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	int32 MaxActiveEnemies = 16;
+
+	/** Enemies spawned and parked on BeginPlay so the first waves don't spawn actors */
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	int32 PrewarmCount = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	float FirstWaveDelay = 2.f;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	float WaveInterval = 20.f;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	double MinSpawnDistance = 1500.f;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	double MaxSpawnDistance = 3000.f;
+
+	/** Patrolling enemies further than this from every player are recycled */
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	double RecycleDistance = 8000.f;
+
+	UPROPERTY(EditAnywhere, Category = "Spawning")
+	int32 SpawnLocationAttempts = 8;
+
+	FTimerHandle WaveTimer;
+
+	UPROPERTY()
+	TArray<AEnemy*> ActiveEnemies;
+
+	UPROPERTY()
+	TArray<AEnemy*> ParkedEnemies;
+
+public:
+	FORCEINLINE int32 GetNumActiveEnemies() const { return ActiveEnemies.Num(); }
+	FORCEINLINE int32 GetNumParkedEnemies() const { return ParkedEnemies.Num(); }
+};
@@ -3,22 +3,30 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Components/WidgetComponent.h"
+#include "Components/SceneComponent.h"
 #include "HealthBarComponent.generated.h"
 
-class UHealthBar;
 /**
- * 
+ * Anchor for a world-space health bar. Bars aren't widgets of their own, the component owns a slot
+ * in UHealthBarSubsystem and ASlashHUD draws every damaged, visible bar in one pass.
  */
-UCLASS()
-class SLASH_API UHealthBarComponent : public UWidgetComponent
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SLASH_API UHealthBarComponent : public USceneComponent
 {
 	GENERATED_BODY()
 
 public:
 	void SetHealthPercent(float Percent);
 
+protected:
+	/** <USceneComponent> */
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnVisibilityChanged() override;
+	/** </USceneComponent> */
+
 private:
-	UPROPERTY()
-	UHealthBar* HealthBarWidget;
+	int32 BarIndex = INDEX_NONE;
+
+	friend class UHealthBarSubsystem;
 };
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HealthBarSubsystem.generated.h"
+
+class UHealthBarComponent;
+
+struct FHealthBarEntry
+{
+	FVector WorldLocation;
+	float Percent;
+	bool bVisible;
+};
+
+/**
+ * Shared buffer behind every UHealthBarComponent in the world, read by ASlashHUD when drawing.
+ * Entries are kept dense, removing a bar moves the last one into its slot.
+ */
+UCLASS()
+class SLASH_API UHealthBarSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterBar(UHealthBarComponent* Component);
+	void UnregisterBar(UHealthBarComponent* Component);
+
+	FORCEINLINE void SetPercent(int32 Index, float Percent) { Entries[Index].Percent = Percent; }
+	FORCEINLINE void SetVisible(int32 Index, bool bVisible) { Entries[Index].bVisible = bVisible; }
+
+	/** Appends the bars worth drawing (damaged, alive and visible) with their current anchor locations */
+	void GatherDrawnBars(TArray<FHealthBarEntry>& OutBars) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TArray<FHealthBarEntry> Entries;
+
+	UPROPERTY()
+	TArray<UHealthBarComponent*> Components;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
+#include "HUD/HealthBarSubsystem.h"
 #include "SlashHUD.generated.h"
 
 class USlashOverlay;
@@ -13,13 +14,37 @@ class SLASH_API ASlashHUD : public AHUD
 {
 	GENERATED_BODY()
 
+public:
+	virtual void DrawHUD() override;
+
 protected:
 	virtual void BeginPlay() override;
 
 private:
+	/** Draws enemy health bars from UHealthBarSubsystem, nearest first, as batched canvas tiles */
+	void DrawHealthBars();
+
 	UPROPERTY(EditDefaultsOnly, Category = Slash)
 	TSubclassOf<USlashOverlay> SlashOverlayClass;
 
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bars")
+	int32 MaxVisibleHealthBars = 32;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bars")
+	double HealthBarMaxDistance = 5000.0;
+
+	/** Size in pixels at 1080p, scaled with the viewport height */
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bars")
+	FVector2D HealthBarSize = FVector2D(100.0, 10.0);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bars")
+	FLinearColor HealthBarColor = FLinearColor(0.8f, 0.05f, 0.05f);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bars")
+	FLinearColor HealthBarBackgroundColor = FLinearColor(0.f, 0.f, 0.f, 0.6f);
+
+	TArray<FHealthBarEntry> DrawnBars;
+
 	UPROPERTY()
 	USlashOverlay* SlashOverlay;
 
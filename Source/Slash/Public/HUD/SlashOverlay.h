@@ -8,6 +8,7 @@
 
 class UProgressBar;
 class UTextBlock;
+class UAttributeComponent;
 
 UCLASS()
 class SLASH_API USlashOverlay : public UUserWidget
@@ -20,7 +21,16 @@ public:
 	void SetGoldCount(int32 Gold);
 	void SetSoulsCount(int32 Souls);
 
+	/** Follows the component's change events instead of being pushed to every frame */
+	void BindAttributes(UAttributeComponent* Attributes);
+	void UnbindAttributes();
+
+protected:
+	virtual void NativeDestruct() override;
+
 private:
+	TWeakObjectPtr<UAttributeComponent> BoundAttributes;
+
 	UPROPERTY(meta = (BindWidget))
 	UProgressBar* HealthProgressBar;
 
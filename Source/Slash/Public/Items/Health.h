@@ -14,6 +14,9 @@ class SLASH_API AHealth : public AItem
 {
 	GENERATED_BODY()
 
+public:
+	virtual void OnAcquiredFromPool() override;
+
 protected:
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
 
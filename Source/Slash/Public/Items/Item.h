@@ -27,6 +27,20 @@ public:
 	AItem();
 	virtual void Tick(float DeltaTime) override;
 
+	/** Called by UItemPoolSubsystem when the item is handed out again / parked */
+	virtual void OnAcquiredFromPool();
+	virtual void OnReleasedToPool();
+
+	/**
+	 * Server only, moves and resets a recycled item on every machine. Movement isn't replicated so the
+	 * hovering and drifting stay local, clients only need to know where the item starts from.
+	 */
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastAcquiredFromPool(FVector_NetQuantize Location, FRotator Rotation);
+
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastReleasedToPool();
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -54,8 +68,14 @@ protected:
 	UFUNCTION()
 	virtual void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
-	virtual void SpawnPickupSystem();
-	virtual void SpawnPickupSound();
+	/** Pickups are decided on the server, every machine plays their effects where the item was */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastPickupEffects(FVector_NetQuantize Location);
+
+	virtual void PlayPickupEffects(const FVector& Location);
+	void SpawnPickupSystem(const FVector& Location);
+	void SpawnPickupSound(const FVector& Location);
+	void ReturnToPool();
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UStaticMeshComponent* ItemMesh;
@@ -74,6 +94,12 @@ protected:
 private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	float RunningTime = 0;
+
+	/** Pool bookkeeping, owned by UItemPoolSubsystem */
+	bool bInPool = false;
+	bool bFromPool = false;
+
+	friend class UItemPoolSubsystem;
 };
 
 template<typename T>
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ItemPoolSettings.generated.h"
+
+class AItem;
+
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Item Pool"))
+class SLASH_API UItemPoolSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UItemPoolSettings();
+
+	/** Number of instances of each item class (pickups and enemy weapons) spawned hidden when the world begins play */
+	UPROPERTY(Config, EditAnywhere, Category = "Pool")
+	TMap<TSoftClassPtr<AItem>, int32> PrewarmCounts;
+
+	/** Log hit/miss counts and peak occupancy per class when the world shuts down */
+	UPROPERTY(Config, EditAnywhere, Category = "Pool")
+	bool bLogStatsOnShutdown = true;
+};
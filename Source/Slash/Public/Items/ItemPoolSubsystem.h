@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPoolSubsystem.generated.h"
+
+class AItem;
+
+USTRUCT()
+struct FItemPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AItem*> FreeItems;
+
+	int32 NumActive = 0;
+	int32 PeakActive = 0;
+	int32 Hits = 0;
+	int32 Misses = 0;
+};
+
+/**
+ * Recycles AItem actors per class instead of spawning and destroying them.
+ * Released items are hidden with collision and tick disabled, acquired items get their state reset
+ * through AItem::OnAcquiredFromPool, both multicast to clients. Classes listed in UItemPoolSettings are pre-warmed on BeginPlay.
+ */
+UCLASS()
+class SLASH_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	AItem* Acquire(TSubclassOf<AItem> ItemClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner = nullptr);
+	void Release(AItem* Item);
+	void Prewarm(TSubclassOf<AItem> ItemClass, int32 Count);
+	void LogStats() const;
+
+	template<typename T>
+	T* Acquire(TSubclassOf<T> ItemClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner = nullptr)
+	{
+		return Cast<T>(Acquire(TSubclassOf<AItem>(ItemClass.Get()), Location, Rotation, NewOwner));
+	}
+
+	/** Returns the item to its world's pool, or destroys it if there is none */
+	static void ReleaseOrDestroy(AItem* Item);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AItem* SpawnItem(UClass* ItemClass, const FVector& Location, const FRotator& Rotation, AActor* NewOwner);
+
+	UPROPERTY()
+	TMap<UClass*, FItemPool> Pools;
+
+public:
+	FORCEINLINE const FItemPool* FindPool(UClass* ItemClass) const { return Pools.Find(ItemClass); }
+};
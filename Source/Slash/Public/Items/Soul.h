@@ -16,12 +16,15 @@ class SLASH_API ASoul : public AItem
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual void OnAcquiredFromPool() override;
 
 protected:
 	virtual void BeginPlay() override;
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
 
 private:
+	void UpdateDesiredZ();
+
 	UPROPERTY(EditAnywhere, Category = "Soul Properties")
 	int32 Souls;
 
@@ -14,8 +14,12 @@ class SLASH_API ATreasure : public AItem
 {
 	GENERATED_BODY()
 
+public:
+	virtual void OnAcquiredFromPool() override;
+
 protected:
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
+	virtual void PlayPickupEffects(const FVector& Location) override;
 
 private:
 	UPROPERTY(EditAnywhere, Category = "Treasure Properties")
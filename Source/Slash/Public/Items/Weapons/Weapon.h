@@ -4,6 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "Items/Item.h"
+#include "CollisionQueryParams.h"
+#include "Combat/SwingHitRegistry.h"
+#include "Combat/BladeSweep.h"
+#include "Items/Weapons/WeaponData.h"
 #include "Weapon.generated.h"
 
 class USoundBase;
@@ -20,17 +24,29 @@ class SLASH_API AWeapon : public AItem
 
 public:
 	AWeapon();
+	virtual void Tick(float DeltaTime) override;
+	virtual void PostLoad() override;
+	virtual void PostActorCreated() override;
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
 	void Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator);
 	void DeactivateGlowEffect();
 	void DisableSphereCollision();
 	void PlayEquipSound();
 	void Unequip(USceneComponent* InParent, FName InSocketName);
 	void AttachMeshToSocket(USceneComponent* InParent, const FName& InSocketName);
+	void SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled);
+	void ResolveSweepHits(uint32 InSwingId, const TArray<FHitResult>& Hits); // Called by UCombatTraceSubsystem
 
-	TArray<AActor*> IgnoreActors;
+	/** <AItem> */
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+	/** </AItem> */
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void OnRep_Owner() override;
 
 	UFUNCTION()
 	void OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -38,19 +54,92 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void CreateFields(const FVector& FieldLocation);
 
+	/** Hits land on the server only, the fields that break geometry collections are created on every machine */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastCreateFields(FVector_NetQuantize FieldLocation);
+
 private:
+	void ResolveLegacyWeaponData();
 	bool ActorIsSameType(AActor* OtherActor);
+	void ResetSwingState();
+	void ClearSwingHits();
+	bool TryRecordSwingHit(AActor* HitTarget);
+	bool TryRecordSwingHit(FSwingHitRegistry& Registry, AActor* HitTarget);
 	void BoxTrace(FHitResult& BoxHit);
-	void ExecuteGetHit(FHitResult& BoxHit);
+	void ExecuteGetHit(const FHitResult& BoxHit);
+	void HitActor(const FHitResult& BoxHit);
+	void ClassifyHitDirections(const TArray<FHitResult>& Hits);
+
+	/** Swept tracing */
+	void BeginSwing();
+	void EndSwing();
+	void SweepBlade();
+	void TraceBladePose(const FVector& Start, const FVector& End, const FQuat& Rotation);
 
+	/** Shared by every instance of the weapon, nullptr uses the UWeaponDataAsset defaults */
 	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
-	FVector BoxTraceExtent = FVector(5.f);
+	UWeaponDataAsset* WeaponData;
+
+	/**
+	 * Built from the deprecated properties of weapons that have no WeaponData yet, until Slash.Weapons.MigrateData
+	 * has been run and its assets are saved. Never saved, instances with their blueprint's values share its copy.
+	 */
+	UPROPERTY(Transient)
+	UWeaponDataAsset* LegacyWeaponData = nullptr;
 
 	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
 	bool bShowDebugBox = false;
 
+	/**
+	 * Trace the blade between its last and current pose every frame of a swing instead of tracing on box overlap.
+	 * Poses are sub-stepped by distance along the arc of the swing, so the swept volume and the hits don't depend on frame rate.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties|Swept Tracing")
+	bool bUseSweptTracing = true;
+
+	/** Keep at or below the trace box width so consecutive poses overlap */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties|Swept Tracing", meta = (EditCondition = "bUseSweptTracing", ClampMin = "1.0"))
+	float MaxSubstepDistance = 10.f;
+
+	/** Guards against hitches only, frames that need more sub-steps are logged and counted in `stat Slash` */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties|Swept Tracing", meta = (EditCondition = "bUseSweptTracing", ClampMin = "1"))
+	int32 MaxSubsteps = 128;
+
+	bool bSwinging = false;
+	bool bReportedSubstepCap = false;
+	FBladeSweep BladeSweep;
+	FTransform PreviousBladeTransform;
+
+	/** Distinct targets a single swing can hit, 0 cleaves through everything */
 	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
-	USoundBase* EquipSound;
+	int32 MaxCleaveTargets = 0;
+
+	/** Seconds before a target can be hit again by the same swing, 0 hits each target once */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
+	float RehitCooldown = 0.f;
+
+	FSwingHitRegistry SwingHits;
+
+	/** Hits of the swing before this one in a combo, async results queued during it are still resolved against it */
+	FSwingHitRegistry PreviousSwingHits;
+	bool bResolvePreviousSwing = false;
+
+	/** Ignores this weapon, its owner and every target that can't be hit again this swing, reused by every trace */
+	FCollisionQueryParams SwingQueryParams;
+
+	/**
+	 * Sweeps find every character mesh and breakable along the blade instead of stopping at the first blocker,
+	 * so the sub-steps of a frame that are queued together don't all end on the same victim
+	 */
+	FCollisionObjectQueryParams SwingObjectParams;
+	TArray<FHitResult> SweepHits;
+
+	/** Hits accepted by the current ResolveSweepHits and the hit react direction of each victim, reused */
+	TArray<int32> AcceptedHits;
+	TArray<FVector> VictimForwards;
+	TArray<FVector> VictimLocations;
+	TArray<FVector> HitFroms;
+	TArray<EHitReactDirection> HitDirections;
 
 	UPROPERTY(VisibleAnywhere, Category = "Weapon Properties")
 	UBoxComponent* WeaponBox;
@@ -61,13 +150,32 @@ private:
 	UPROPERTY(VisibleAnywhere)
 	USceneComponent* BoxTraceEnd;
 
-	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
-	float Damage = 20.f;
+#if WITH_EDITORONLY_DATA
+	/**
+	 * Properties saved before weapon data assets, moved into shared data assets by Slash.Weapons.MigrateData.
+	 * Read into LegacyWeaponData until then.
+	 */
+	UPROPERTY()
+	FString WeaponType_DEPRECATED = "One-Handed";
 
-	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
-	FString WeaponType = "One-Handed";
+	UPROPERTY()
+	float Damage_DEPRECATED = 20.f;
+
+	UPROPERTY()
+	FVector BoxTraceExtent_DEPRECATED = FVector(5.f);
+
+	UPROPERTY()
+	USoundBase* EquipSound_DEPRECATED = nullptr;
+#endif
+
+	friend struct FWeaponDataMigration;
 
 public:
 	FORCEINLINE UBoxComponent* GetWeaponBox() const { return WeaponBox; }
-	FORCEINLINE FString GetWeaponType() const { return WeaponType; }
+	FORCEINLINE const UWeaponDataAsset* GetWeaponData() const
+	{
+		if (WeaponData) return WeaponData;
+		return LegacyWeaponData ? LegacyWeaponData : GetDefault<UWeaponDataAsset>();
+	}
+	FORCEINLINE EWeaponType GetWeaponType() const { return GetWeaponData()->WeaponType; }
 };
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Characters/CharacterTypes.h"
+#include "WeaponData.generated.h"
+
+class UAnimMontage;
+class USoundBase;
+
+/**
+ * Everything that is the same for every instance of a weapon, e.g. one asset per sword.
+ * Montages left empty fall back to the wielder's own montages for the weapon type.
+ */
+UCLASS(BlueprintType)
+class SLASH_API UWeaponDataAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	EWeaponType WeaponType = EWeaponType::EWT_OneHanded;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	float Damage = 20.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	FVector BoxTraceExtent = FVector(5.f);
+
+	/** Wielder's socket while armed */
+	UPROPERTY(EditDefaultsOnly, Category = "Sockets")
+	FName HandSocket = FName("RightHandSocket");
+
+	/** Wielder's socket while disarmed, e.g. ThighSocket or NeckSocket */
+	UPROPERTY(EditDefaultsOnly, Category = "Sockets")
+	FName SheathSocket = FName("ThighSocket");
+
+	UPROPERTY(EditDefaultsOnly, Category = "Montages")
+	UAnimMontage* AttackMontage = nullptr;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Montages")
+	UAnimMontage* EquipMontage = nullptr;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Sounds")
+	USoundBase* EquipSound = nullptr;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NetBandwidthSubsystem.generated.h"
+
+class UNetConnection;
+
+/**
+ * Bandwidth per player, sampled from the net driver's connections every Slash.Net.StatsInterval seconds.
+ * A server measures each remote player's connection, a client its connection to the server.
+ * Slash.Net.Bandwidth logs the latest rates. With -SlashNetStats every sample goes to
+ * Saved/Benchmarks/NetBandwidth-<date>.csv and a per-player summary goes to the .json when the world ends.
+ * To test on one Linux box, run a listen server and local clients, each in its own shell:
+ *   UnrealEditor Slash.uproject <Map>?listen -game -log -windowed -ResX=960 -ResY=540 -SlashNetStats
+ *   UnrealEditor Slash.uproject 127.0.0.1 -game -log -windowed -ResX=960 -ResY=540
+ * Use NetEmulation.PktLag and NetEmulation.PktLoss to add latency and loss.
+ */
+UCLASS()
+class SLASH_API UNetBandwidthSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	void LogRates() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FConnectionStats
+	{
+		FString PlayerName;
+		uint64 LastOutBytes = 0;
+		uint64 LastInBytes = 0;
+		uint64 TotalOutBytes = 0;
+		uint64 TotalInBytes = 0;
+		double Seconds = 0.0;
+		double OutBytesPerSecond = 0.0;
+		double InBytesPerSecond = 0.0;
+		double PeakOutBytesPerSecond = 0.0;
+	};
+
+	void Sample();
+	void SampleConnection(UNetConnection* Connection, double Interval);
+	void WriteReport() const;
+
+	/** Players who left stay in the report */
+	TMap<TObjectKey<UNetConnection>, FConnectionStats> Connections;
+
+	FString Csv;
+	FString ReportPath;
+	double StartTime = 0.0;
+	double LastSampleTime = 0.0;
+};
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RandomStreamSubsystem.generated.h"
+
+enum class ERandomStream : uint8
+{
+	ERS_AI,
+	ERS_Combat,
+	ERS_Loot,
+	ERS_Animation,
+
+	ERS_MAX
+};
+
+/**
+ * Source of all gameplay randomness in a world. Each ERandomStream is seeded independently from the
+ * session seed, so drawing more numbers in one system doesn't shift the sequence of another.
+ * The session seed comes from -SlashSeed=, USlashBenchmarkSubsystem, or the clock, and is logged
+ * on startup so any session can be repeated by passing it back on the command line.
+ */
+UCLASS()
+class SLASH_API URandomStreamSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	/** </UWorldSubsystem> */
+
+	/** Re-seeds every substream, e.g. for a benchmark run with a fixed seed */
+	void SetSeed(int32 NewSeed);
+
+	/** Returns the world's stream, or a shared one seeded with -SlashSeed= (0 without it) when the world has no subsystem */
+	static FRandomStream& GetStream(const UObject* WorldContextObject, ERandomStream Stream);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	int32 Seed = 0;
+	FRandomStream Streams[static_cast<int32>(ERandomStream::ERS_MAX)];
+
+public:
+	FORCEINLINE int32 GetSeed() const { return Seed; }
+	FORCEINLINE FRandomStream& GetStream(ERandomStream Stream) { return Streams[static_cast<int32>(Stream)]; }
+};
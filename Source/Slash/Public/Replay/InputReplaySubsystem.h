@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Benchmark/SlashBenchmarkReport.h"
+#include "InputReplaySubsystem.generated.h"
+
+class UEnhancedInputComponent;
+class UInputAction;
+struct FInputActionInstance;
+
+/**
+ * Records the player's input actions to a file and plays them back, only created with one of
+ *   -SlashRecordInput[=<file>]   records to <file> or Saved/Replays/Slash-<time>.slashreplay
+ *   -SlashReplay=<file>          replays <file>, e.g. headless with -game -nullrhi -unattended
+ * A recording holds the random seed, every frame's delta time, the triggered actions with their values
+ * and the player's location every CheckpointInterval frames. Playback re-seeds URandomStreamSubsystem,
+ * steps the engine with the recorded delta times and feeds the actions to the player's ASlashCharacter,
+ * then writes the same timing report as USlashBenchmarkSubsystem (-ReplayReport=<path without extension>)
+ * and exits unless -ReplayNoExit is given. Checkpoints that drift are logged, the usual cause is a
+ * time based budget such as Slash.AI.BudgetMs. A recording without input actions is logged as a warning and
+ * refused for playback.
+ */
+UCLASS()
+class SLASH_API UInputReplaySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	/** Adds recording bindings for the actions, after the owner's own bindings */
+	void RecordActions(UEnhancedInputComponent* InputComponent, TArrayView<UInputAction* const> Actions);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EReplayRecord : uint8
+	{
+		ERR_Frame,
+		ERR_Action,
+		ERR_Input,
+		ERR_Checkpoint,
+		ERR_End
+	};
+
+	static constexpr uint32 FileMagic = 0x4C505253; // "SRPL"
+	static constexpr uint32 FileVersion = 1;
+	static constexpr uint32 CheckpointInterval = 60;
+	static constexpr float CheckpointTolerance = 1.f;
+
+	void StartRecording(UWorld& InWorld, const FString& Filename);
+	void StopRecording();
+	void OnActionTriggered(const FInputActionInstance& Instance);
+
+	void StartReplay(UWorld& InWorld, const FString& Filename);
+	void ReplayFrame();
+	void FinishReplay();
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	bool GetPlayerLocation(FVector& OutLocation) const;
+
+	TUniquePtr<FArchive> Recording;
+	TUniquePtr<FArchive> Replay;
+	bool bReplaying = false;
+	uint32 Frame = 0;
+	uint32 NumRecordedInputs = 0;
+	uint32 NumDivergedCheckpoints = 0;
+	int32 Seed = 0;
+
+	/** Indexed as written to the file, the assets are kept loaded by the characters that bound them */
+	TArray<const UInputAction*> Actions;
+
+	FSlashBenchmarkReport Report;
+	FString ReplayFilename;
+	FString ReportPath;
+	bool bExitWhenDone = true;
+
+	FDelegateHandle WorldTickStartHandle;
+};
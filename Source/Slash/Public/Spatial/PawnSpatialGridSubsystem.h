@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Spatial/SpatialHashGrid.h"
+#include "PawnSpatialGridSubsystem.generated.h"
+
+/**
+ * Spatial index of registered pawns, refreshed once per frame.
+ * Used for enemy sight checks instead of UPawnSensingComponent, which iterates every pawn per sensor.
+ */
+UCLASS()
+class SLASH_API UPawnSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UTickableWorldSubsystem> */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </UTickableWorldSubsystem> */
+
+	void RegisterPawn(APawn* Pawn);
+	void UnregisterPawn(APawn* Pawn);
+
+	void QueryPawnsInRadius(const FVector& Center, double Radius, TArray<APawn*>& OutPawns) const;
+	void QueryPawnsInCone(const FVector& Origin, const FVector& Direction, double Radius, float HalfAngleDegrees, TArray<APawn*>& OutPawns) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void GatherPawns(TArray<APawn*>& OutPawns) const;
+
+	FSpatialHashGrid Grid;
+
+	/** Indexed by grid handle */
+	UPROPERTY()
+	TArray<APawn*> HandleToPawn;
+
+	TMap<TObjectKey<APawn>, int32> PawnToHandle;
+
+	mutable TArray<int32> QueryHandles;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform 2D hash grid over world XY. Elements are addressed by the handle returned from Add
+ * and only change buckets when they cross a cell boundary, so per-frame updates are cheap.
+ * Queries test the exact 3D distance, the grid only narrows down the candidates.
+ */
+class SLASH_API FSpatialHashGrid
+{
+public:
+	explicit FSpatialHashGrid(double InCellSize = 1000.0);
+
+	int32 Add(const FVector& Location);
+	void Remove(int32 Handle);
+	void Update(int32 Handle, const FVector& Location);
+	void Reset();
+
+	/** Appends the handles of all elements within Radius of Center */
+	void QueryRadius(const FVector& Center, double Radius, TArray<int32>& OutHandles) const;
+
+	/** Like QueryRadius, but also within HalfAngleDegrees of Direction (expected to be normalized) */
+	void QueryCone(const FVector& Origin, const FVector& Direction, double Radius, float HalfAngleDegrees, TArray<int32>& OutHandles) const;
+
+private:
+	struct FElement
+	{
+		FVector Location;
+		FIntPoint Cell;
+		int32 IndexInCell;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(int32 Handle, const FIntPoint& Cell);
+	void RemoveFromCell(int32 Handle);
+
+	template<typename PredicateType>
+	void GatherInRadius(const FVector& Center, double Radius, TArray<int32>& OutHandles, PredicateType Predicate) const;
+
+	double CellSize;
+	double InvCellSize;
+	TSparseArray<FElement> Elements;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+public:
+	FORCEINLINE const FVector& GetLocation(int32 Handle) const { return Elements[Handle].Location; }
+	FORCEINLINE bool IsValidHandle(int32 Handle) const { return Elements.IsValidIndex(Handle); }
+	FORCEINLINE int32 Num() const { return Elements.Num(); }
+	FORCEINLINE double GetCellSize() const { return CellSize; }
+};
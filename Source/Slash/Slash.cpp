@@ -2,5 +2,18 @@
 
 #include "Slash.h"
 #include "Modules/ModuleManager.h"
+#include "Slash/SlashStats.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Slash, "Slash" );
+DEFINE_LOG_CATEGORY(LogSlash);
+
+class FSlashModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// Slash.Stats.Enabled only toggles the channel when it changes, it starts out matching the default here
+		UE::Trace::ToggleChannel(TEXT("Slash"), GSlashStatsEnabled);
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FSlashModule, Slash, "Slash" );
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Slash/SlashStats.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_STAT(STAT_SlashEnemyAI);
+DEFINE_STAT(STAT_SlashEnemySight);
+DEFINE_STAT(STAT_SlashPawnGrid);
+DEFINE_STAT(STAT_SlashCombatTraces);
+DEFINE_STAT(STAT_SlashWeaponSweep);
+DEFINE_STAT(STAT_SlashWeaponBoxTrace);
+DEFINE_STAT(STAT_SlashItemTick);
+DEFINE_STAT(STAT_SlashAttributeRegen);
+DEFINE_STAT(STAT_SlashSoulGroundTrace);
+DEFINE_STAT(STAT_SlashOverlayUpdate);
+DEFINE_STAT(STAT_SlashHealthBars);
+DEFINE_STAT(STAT_SlashAnimSnapshot);
+
+DEFINE_STAT(STAT_SlashLiveEnemies);
+DEFINE_STAT(STAT_SlashEnemiesEngaged);
+DEFINE_STAT(STAT_SlashEnemiesNear);
+DEFINE_STAT(STAT_SlashEnemiesFar);
+DEFINE_STAT(STAT_SlashEnemiesDormant);
+DEFINE_STAT(STAT_SlashTraces);
+DEFINE_STAT(STAT_SlashRegeneratingAttributes);
+DEFINE_STAT(STAT_SlashCappedSweeps);
+DEFINE_STAT(STAT_SlashPickupsSpawned);
+
+UE_TRACE_CHANNEL_DEFINE(SlashChannel);
+
+bool GSlashStatsEnabled = true;
+
+static FAutoConsoleVariableRef CVarSlashStatsEnabled(
+	TEXT("Slash.Stats.Enabled"),
+	GSlashStatsEnabled,
+	TEXT("Enables the Slash cycle counters (stat Slash) and the Slash Insights trace channel."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+	{
+		UE::Trace::ToggleChannel(TEXT("Slash"), GSlashStatsEnabled);
+	}),
+	ECVF_Default);
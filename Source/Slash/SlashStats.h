@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Benchmark/SlashBenchmarkTimers.h"
+
+/**
+ * `stat Slash` and the "Slash" Insights channel. Slash.Stats.Enabled turns the cycle counters
+ * and the trace channel on or off together, the dword counters are always kept.
+ */
+DECLARE_STATS_GROUP(TEXT("Slash"), STATGROUP_Slash, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy AI"), STAT_SlashEnemyAI, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Sight"), STAT_SlashEnemySight, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pawn Grid Update"), STAT_SlashPawnGrid, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat Trace Resolve"), STAT_SlashCombatTraces, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Sweep"), STAT_SlashWeaponSweep, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Box Trace"), STAT_SlashWeaponBoxTrace, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Item Tick"), STAT_SlashItemTick, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attribute Regen"), STAT_SlashAttributeRegen, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Soul Ground Trace"), STAT_SlashSoulGroundTrace, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Overlay Update"), STAT_SlashOverlayUpdate, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Health Bars"), STAT_SlashHealthBars, STATGROUP_Slash, SLASH_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Snapshot"), STAT_SlashAnimSnapshot, STATGROUP_Slash, SLASH_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Live Enemies"), STAT_SlashLiveEnemies, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemies Engaged"), STAT_SlashEnemiesEngaged, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemies Near"), STAT_SlashEnemiesNear, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemies Far"), STAT_SlashEnemiesFar, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemies Dormant"), STAT_SlashEnemiesDormant, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_SlashTraces, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Regenerating Attributes"), STAT_SlashRegeneratingAttributes, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Capped Weapon Sweeps"), STAT_SlashCappedSweeps, STATGROUP_Slash, SLASH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pickups Spawned"), STAT_SlashPickupsSpawned, STATGROUP_Slash, SLASH_API);
+
+UE_TRACE_CHANNEL_EXTERN(SlashChannel, SLASH_API);
+
+extern SLASH_API bool GSlashStatsEnabled;
+
+/** Cycle counter, Insights scope and benchmark timer for the enclosing scope */
+#define SLASH_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CONDITIONAL_CYCLE_COUNTER(Stat, GSlashStatsEnabled); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, SlashChannel); \
+	SLASH_BENCHMARK_SCOPE(#Stat)
+
+/** Counts a gameplay trace for `stat Slash` and the benchmark report */
+#define SLASH_COUNT_TRACE() \
+	INC_DWORD_STAT(STAT_SlashTraces); \
+	SLASH_BENCHMARK_COUNT_TRACE()